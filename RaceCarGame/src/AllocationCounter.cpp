@@ -0,0 +1,248 @@
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+#ifndef NDEBUG
+
+#ifdef _WIN32
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+static std::atomic<std::uint64_t> g_allocations{ 0 };
+static std::atomic<std::int64_t> g_heapBytes{ 0 };
+static std::atomic<std::int64_t> g_peakHeapBytes{ 0 };
+
+// Block sizes come from the C runtime rather than a header in front of each block, so
+// a block may be freed by code that didn't allocate it: with SFML as DLLs, strings grown
+// inside SFML are released through this operator delete, and the other way round. That
+// only needs one C runtime, which the DLL builds of SFML share with the game (/MD). Blocks
+// allocated inside a DLL but freed here are subtracted without ever having been added, so
+// the in-use count can dip below what the game itself holds; it is clamped at zero.
+static std::size_t blockBytes(void* p) {
+#ifdef _WIN32
+    return _msize(p);
+#elif defined(__APPLE__)
+    return malloc_size(p);
+#else
+    return malloc_usable_size(p);
+#endif
+}
+
+static std::size_t alignedBlockBytes(void* p, std::size_t alignment) {
+#ifdef _WIN32
+    return _aligned_msize(p, alignment, 0);
+#else
+    (void)alignment;
+    return blockBytes(p);
+#endif
+}
+
+static void noteAllocated(std::size_t bytes) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    std::int64_t inUse = g_heapBytes.fetch_add(std::int64_t(bytes), std::memory_order_relaxed) + std::int64_t(bytes);
+    std::int64_t peak = g_peakHeapBytes.load(std::memory_order_relaxed);
+    while (inUse > peak && !g_peakHeapBytes.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {}
+}
+
+static void noteFreed(std::size_t bytes) {
+    g_heapBytes.fetch_sub(std::int64_t(bytes), std::memory_order_relaxed);
+}
+
+static void* allocate(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) return nullptr;
+    noteAllocated(blockBytes(p));
+    return p;
+}
+
+static void* allocateAligned(std::size_t size, std::align_val_t align) {
+    std::size_t alignment = std::max(std::size_t(align), sizeof(void*));
+    if (size == 0) size = 1;
+#ifdef _WIN32
+    void* p = _aligned_malloc(size, alignment);
+    if (!p) return nullptr;
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p, alignment, size) != 0) return nullptr;
+#endif
+    noteAllocated(alignedBlockBytes(p, alignment));
+    return p;
+}
+
+static void release(void* p) {
+    if (!p) return;
+    noteFreed(blockBytes(p));
+    std::free(p);
+}
+
+static void releaseAligned(void* p, std::align_val_t align) {
+    if (!p) return;
+    std::size_t alignment = std::max(std::size_t(align), sizeof(void*));
+    noteFreed(alignedBlockBytes(p, alignment));
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+// Every replaceable form, so nothing reaches the runtime's own allocator uncounted
+void* operator new(std::size_t size) {
+    void* p = allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    void* p = allocateAligned(size, align);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+
+void operator delete(void* p) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, std::align_val_t align) noexcept {
+    releaseAligned(p, align);
+}
+
+void operator delete[](void* p, std::align_val_t align) noexcept {
+    releaseAligned(p, align);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept {
+    releaseAligned(p, align);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t align) noexcept {
+    releaseAligned(p, align);
+}
+
+void operator delete(void* p, std::align_val_t align, const std::nothrow_t&) noexcept {
+    releaseAligned(p, align);
+}
+
+void operator delete[](void* p, std::align_val_t align, const std::nothrow_t&) noexcept {
+    releaseAligned(p, align);
+}
+
+std::uint64_t allocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+bool allocationCountingEnabled() {
+    return true;
+}
+
+std::uint64_t heapBytesInUse() {
+    return std::uint64_t(std::max<std::int64_t>(0, g_heapBytes.load(std::memory_order_relaxed)));
+}
+
+std::uint64_t peakHeapBytes() {
+    return std::uint64_t(std::max<std::int64_t>(0, g_peakHeapBytes.load(std::memory_order_relaxed)));
+}
+
+#else
+
+std::uint64_t allocationCount() {
+    return 0;
+}
+
+bool allocationCountingEnabled() {
+    return false;
+}
+
+std::uint64_t heapBytesInUse() {
+    return 0;
+}
+
+std::uint64_t peakHeapBytes() {
+    return 0;
+}
+
+#endif
+
+std::uint64_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return std::uint64_t(usage.ru_maxrss);         // bytes
+#else
+    return std::uint64_t(usage.ru_maxrss) * 1024;  // kilobytes
+#endif
+#endif
+}
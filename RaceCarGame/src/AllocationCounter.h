@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// Number of global operator new calls made so far, from any thread.
+// Only counted in debug builds; release builds always return 0.
+std::uint64_t allocationCount();
+
+// True when allocationCount() is live (debug builds)
+bool allocationCountingEnabled();
+
+// Frames (or headless ticks) after the game starts or changes screen before it must
+// stop allocating
+const int ALLOCATION_WARMUP_FRAMES = 120;
+
+// Bytes currently held through global operator new, and the most ever held at once,
+// as the C runtime sizes the blocks (requests rounded up to its granularity).
+// Counted alongside allocationCount(), so also 0 in release builds.
+std::uint64_t heapBytesInUse();
+std::uint64_t peakHeapBytes();
+
+// Most physical memory the process has had resident so far, as the OS reports it
+// (heap, code, stacks, driver and audio buffers); counted in every build
+std::uint64_t peakResidentBytes();
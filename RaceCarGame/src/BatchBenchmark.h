@@ -0,0 +1,119 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "BatchSimulation.h"
+#include "FrameSnapshot.h"
+#include "GameOptions.h"
+#include "GameRules.h"
+#include "Headless.h"
+#include "InputQueue.h"
+#include "Simulation.h"
+#include "WorkerPool.h"
+
+// The benchmark's stand-in for a player: occasional lane changes and boosts, and a
+// restart some time after every crash. Only depends on its arguments.
+inline PlayerAction batchTestAction(int env, std::uint64_t step, bool over) {
+    std::uint32_t h = std::uint32_t(env) * 2654435761u ^ std::uint32_t(step) * 2246822519u;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    if (over) return h % 30 == 0 ? ACTION_RESTART : ACTION_NONE;
+    int roll = int(h % 1000);
+    if (roll < 20) return ACTION_LEFT;
+    if (roll < 40) return ACTION_RIGHT;
+    if (roll < 43) return ACTION_BOOST;
+    return ACTION_NONE;
+}
+
+// Feed one environment's actions to a real Simulation, one press and release per
+// action on the tick it was applied, and return the final fingerprint
+inline std::uint64_t replayThroughSimulation(unsigned seed, const SpriteSizes& sizes, const std::vector<std::uint8_t>& actions) {
+    const sf::Keyboard::Key keys[] = { sf::Keyboard::Unknown, sf::Keyboard::Left, sf::Keyboard::Right, sf::Keyboard::Space, sf::Keyboard::Y };
+    std::vector<InputEvent> events;
+    for (std::size_t i = 0; i < actions.size(); i++) {
+        if (actions[i] == ACTION_NONE) continue;
+        InputEvent e;
+        e.key = keys[actions[i]];
+        e.tick = i + 1;
+        e.pressed = true;
+        events.push_back(e);
+        e.pressed = false;
+        events.push_back(e);
+    }
+
+    Simulation sim(seed, sizes, GameOptions());
+    InputQueue input;
+    input.play(&events);
+    FrameSnapshot frame;
+    frame.reserve();
+    for (std::size_t i = 0; i < actions.size(); i++) sim.tick(frame, input, 0);
+    return sim.checksum();
+}
+
+// --batch=ENVS: step ENVS games in lockstep for --batch-steps ticks on --threads threads,
+// report environment steps per second, then replay a sample of the environments
+// through Simulation and check they end in exactly the same state
+inline int runBatchBenchmark(const GameOptions& options) {
+    const int envs = options.batchEnvs;
+    const unsigned firstSeed = options.seed != 0 ? options.seed : 1;
+    SpriteSizes sizes = loadSpriteSizes();
+
+    std::vector<unsigned> seeds(envs);
+    for (int i = 0; i < envs; i++) seeds[i] = firstSeed + unsigned(i);
+
+    WorkerPool pool(options.threads);
+    auto setupStart = std::chrono::steady_clock::now();
+    BatchSimulation batch(seeds, sizes, pool);
+    double setupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+
+    std::vector<std::uint8_t> actions(envs);
+    std::vector<float> observations(std::size_t(envs) * OBSERVATION_SIZE);
+    batch.observeAll(observations.data());
+
+    // Keep the actions of a spread of environments for the check against Simulation
+    const int checked = std::min(envs, 16);
+    std::vector<std::vector<std::uint8_t>> checkedActions(checked);
+    for (std::vector<std::uint8_t>& a : checkedActions) a.reserve(options.batchSteps);
+
+    std::vector<std::uint8_t> wasOver(envs);
+    double seconds = 0;
+    std::uint64_t crashes = 0, restarts = 0;
+    for (int step = 0; step < options.batchSteps; step++) {
+        for (int env = 0; env < envs; env++) {
+            wasOver[env] = observations[std::size_t(env) * OBSERVATION_SIZE + OBS_OVER] != 0;
+            actions[env] = std::uint8_t(batchTestAction(env, std::uint64_t(step), wasOver[env] != 0));
+        }
+        for (int i = 0; i < checked; i++) checkedActions[i].push_back(actions[std::size_t(i) * envs / checked]);
+
+        auto stepStart = std::chrono::steady_clock::now();
+        batch.step(actions.data(), observations.data());
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+
+        for (int env = 0; env < envs; env++) {
+            if (wasOver[env] && actions[env] == ACTION_RESTART) restarts++;
+            if (!wasOver[env] && batch.gameOver(env)) crashes++;
+        }
+    }
+
+    std::uint64_t envSteps = std::uint64_t(envs) * std::uint64_t(options.batchSteps);
+    std::cout << "Batch simulation: " << envs << " environments, " << pool.size() << " threads, "
+        << options.batchSteps << " steps, setup " << setupMs << " ms" << std::endl;
+    std::cout << "Stepped in " << seconds * 1000 << " ms: " << (seconds > 0 ? envSteps / seconds : 0)
+        << " env-steps/s, " << (options.batchSteps > 0 ? seconds * 1e6 / options.batchSteps : 0) << " us per step" << std::endl;
+    std::cout << crashes << " crashes, " << restarts << " restarts" << std::endl;
+
+    int matching = 0;
+    for (int i = 0; i < checked; i++) {
+        int env = int(std::size_t(i) * envs / checked);
+        std::uint64_t expected = replayThroughSimulation(seeds[env], sizes, checkedActions[i]);
+        if (expected == batch.checksum(env)) matching++;
+        else std::cerr << "Environment " << env << " (seed " << seeds[env] << ") differs from Simulation: "
+            << std::hex << batch.checksum(env) << " vs " << expected << std::dec << std::endl;
+    }
+    std::cout << "Single-instance check: " << matching << " of " << checked << " environments match Simulation" << std::endl;
+    return matching == checked ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+#include "GameRules.h"
+#include "QualityGovernor.h"
+#include "Track.h"
+#include "TrackGenerator.h"
+#include "WorkerPool.h"
+
+// What BatchSimulation writes for each environment, OBSERVATION_SIZE floats in this order
+enum ObservationField {
+    OBS_LANE,          // player lane, 0..NUM_LANES-1
+    OBS_PLAYER_X,      // player position across the road, -0.6..0.6
+    OBS_SPEED,         // 0.5 cruising, 1 boosting
+    OBS_BOOSTS_LEFT,
+    OBS_BOOSTING,      // 0 or 1
+    OBS_OVER,          // 1 once crashed, until a restart
+    OBS_LANE_AHEAD,    // OBS_LANE_AHEAD + lane: distance to the next car in that lane
+    OBS_NEXT_CAR = OBS_LANE_AHEAD + NUM_LANES,  // distance to the next car in any lane
+    OBSERVATION_SIZE
+};
+
+// Distances are in units of this many segments; 1 means nothing that close
+const int OBSERVATION_RANGE = OPPONENT_DRAW_SEGMENTS;
+
+// Many independent games stepped in lockstep, for automated playtesting and training.
+// Each environment has its own seed, player and opponents, and follows the same rules
+// as Simulation: the same seed and the same presses on the same ticks end in the same
+// state (see checksum()). Nothing is rendered; collisions are found by projecting only
+// the road up to the furthest car in the player's lane.
+//
+// Player state is kept as one array per field and opponents as per-segment lane, type
+// and offset arrays, so a step walks memory linearly. Road geometry is shared.
+class BatchSimulation {
+public:
+    BatchSimulation(const std::vector<unsigned>& seeds, const SpriteSizes& sizes, WorkerPool& workers)
+        : sprites(sizes), pool(workers), count(int(seeds.size())) {
+        buildRoad(road, TRACK_SEGMENTS);
+        buildViewMaxY(road, VIEW_SEGMENTS, viewMaxY);
+
+        tickCount.assign(count, 0);
+        PlayerState start;
+        pos.assign(count, start.pos);
+        playerLane.assign(count, start.playerLane);
+        playerX.assign(count, start.playerX);
+        targetX.assign(count, start.targetX);
+        score.assign(count, start.score);
+        speed.assign(count, start.speed);
+        boostsLeft.assign(count, start.boostsLeft);
+        boostTimer.assign(count, start.boostTimer);
+        isBoosting.assign(count, start.isBoosting);
+        isOver.assign(count, start.isOver);
+
+        trackSeed = seeds;
+        trackGeneration.assign(count, 0);
+        random.reserve(count);
+        for (unsigned seed : seeds) random.emplace_back(seed);
+
+        std::size_t cells = std::size_t(count) * TRACK_SEGMENTS;
+        opponentLane.assign(cells, -1);
+        opponentType.assign(cells, 0);
+        opponentOffset.assign(cells, 0);
+
+        pool.parallelFor(count, [this](int begin, int end, int) {
+            for (int env = begin; env < end; env++) placeTrack(env);
+        });
+    }
+
+    int size() const { return count; }
+
+    // Apply actions[env] (a PlayerAction) to every environment, advance each one tick and
+    // write size() * OBSERVATION_SIZE floats to `observations`
+    void step(const std::uint8_t* actions, float* observations) {
+        pool.parallelFor(count, [&](int begin, int end, int) {
+            for (int env = begin; env < end; env++) {
+                stepEnv(env, PlayerAction(actions[env]));
+                observe(env, observations + std::size_t(env) * OBSERVATION_SIZE);
+            }
+        });
+    }
+
+    // Current observations without stepping, e.g. before the first step
+    void observeAll(float* observations) const {
+        for (int env = 0; env < count; env++) observe(env, observations + std::size_t(env) * OBSERVATION_SIZE);
+    }
+
+    int currentScore(int env) const { return score[env]; }
+    bool gameOver(int env) const { return isOver[env] != 0; }
+    std::uint64_t ticks(int env) const { return tickCount[env]; }
+
+    // Same fingerprint as Simulation::checksum
+    std::uint64_t checksum(int env) const {
+        std::uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](std::uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+        mix(tickCount[env]);
+        mix(std::uint64_t(pos[env]));
+        mix(std::uint64_t(playerLane[env]));
+        mix(std::uint64_t(score[env]));
+        mix(std::uint64_t(boostsLeft[env]));
+        mix(std::uint64_t(isOver[env] != 0));
+        const std::int8_t* lanes = &opponentLane[std::size_t(env) * TRACK_SEGMENTS];
+        for (int i = 0; i < TRACK_SEGMENTS; i++) {
+            if (lanes[i] >= 0) mix(std::uint64_t(i) * 4 + std::uint64_t(lanes[i]));
+        }
+        return h;
+    }
+
+private:
+    PlayerState load(int env) const {
+        PlayerState p;
+        p.pos = pos[env];
+        p.playerLane = playerLane[env];
+        p.playerX = playerX[env];
+        p.targetX = targetX[env];
+        p.score = score[env];
+        p.speed = speed[env];
+        p.boostsLeft = boostsLeft[env];
+        p.boostTimer = boostTimer[env];
+        p.isBoosting = isBoosting[env] != 0;
+        p.isOver = isOver[env] != 0;
+        return p;
+    }
+
+    void store(int env, const PlayerState& p) {
+        pos[env] = p.pos;
+        playerLane[env] = p.playerLane;
+        playerX[env] = p.playerX;
+        targetX[env] = p.targetX;
+        score[env] = p.score;
+        speed[env] = p.speed;
+        boostsLeft[env] = p.boostsLeft;
+        boostTimer[env] = p.boostTimer;
+        isBoosting[env] = p.isBoosting;
+        isOver[env] = p.isOver;
+    }
+
+    // The opponents generateTrack would place for this environment's seed and race;
+    // scenery draws from its own cells, so it can be left out
+    void placeTrack(int env) {
+        std::size_t base = std::size_t(env) * TRACK_SEGMENTS;
+        std::fill(opponentLane.begin() + base, opponentLane.begin() + base + TRACK_SEGMENTS, std::int8_t(-1));
+
+        TrackKey key{ trackSeed[env], trackGeneration[env] };
+        for (int r = 0; r < key.spawns->count; r++) {
+            if (key.spawns->rules[r].kind != OPPONENT_SPAWN) continue;
+            forEachSpawn(key, r, 0, TRACK_SEGMENTS, [&](int segment, CounterRandom& random) {
+                Line placed;
+                placeOpponent(placed, random);
+                opponentLane[base + segment] = std::int8_t(placed.opponentLane);
+                opponentType[base + segment] = std::uint8_t(placed.opponentType);
+                opponentOffset[base + segment] = placed.opponentOffset;
+            });
+        }
+    }
+
+    // Simulation::handleInput followed by Simulation::tick
+    void stepEnv(int env, PlayerAction action) {
+        PlayerState p = load(env);
+        if (p.isOver && action == ACTION_RESTART) {
+            resetPlayer(p);
+            trackGeneration[env]++;
+            placeTrack(env);
+        }
+        else {
+            applyAction(p, action);
+        }
+
+        tickCount[env]++;
+        if (!p.isOver) {
+            std::size_t base = std::size_t(env) * TRACK_SEGMENTS;
+            TrackRandom& r = random[env];
+            advancePlayer(p, TRACK_SEGMENTS);
+            spawnOpponents(p, TRACK_SEGMENTS, r,
+                [&](int i) { return opponentLane[base + i] >= 0; },
+                [&](int i) {
+                    Line placed;
+                    placeOpponent(placed, r);
+                    opponentLane[base + i] = std::int8_t(placed.opponentLane);
+                    opponentType[base + i] = std::uint8_t(placed.opponentType);
+                    opponentOffset[base + i] = placed.opponentOffset;
+                });
+            if (collides(env, p)) p.isOver = true;
+        }
+        store(env, p);
+    }
+
+    // The projection and collision test of Simulation::buildFrame, limited to what can
+    // decide the outcome: cars in the player's lane, up to the last one in range
+    bool collides(int env, const PlayerState& p) const {
+        const int N = TRACK_SEGMENTS;
+        std::size_t base = std::size_t(env) * N;
+        const std::int8_t* lanes = &opponentLane[base];
+
+        int startPos = p.pos / SEG_LEN;
+        int end = startPos + std::min(OPPONENT_DRAW_SEGMENTS, QUALITY_LEVELS[QUALITY_LEVEL_COUNT - 1].viewSegments);
+        int last = -1;
+        for (int n = end - 1; n >= startPos; n--) {
+            if (lanes[n % N] == p.playerLane) {
+                last = n;
+                break;
+            }
+        }
+        if (last < 0) return false;
+
+        int camH = int(road[startPos].y) + 1500;
+        int maxy = HEIGHT;
+        float x = 0, dx = 0;
+        float farScale = CAM_D / float(QUALITY_LEVELS[QUALITY_LEVEL_COUNT - 1].viewSegments * SEG_LEN);
+        sf::FloatRect playerRect = playerCollisionRect(p.playerX);
+
+        for (int n = startPos; n <= last; n++) {
+            Line l = road[n % N];
+            l.project(int(p.playerX * ROAD_W / 2 - x), camH, startPos * SEG_LEN - (n >= N ? N * SEG_LEN : 0));
+            x += dx;
+            dx += l.curve;
+
+            // Past the horizon nothing is laid out, so nothing further can be hit
+            if (pastHorizon(l.scale, farScale, viewMaxY[n % N] - camH, maxy)) return false;
+            if (l.Y < maxy) maxy = int(l.Y);
+
+            if (lanes[n % N] != p.playerLane || !(l.Y < HEIGHT && l.Y > -100)) continue;
+            l.hasOpponent = true;
+            l.opponentLane = lanes[n % N];
+            l.opponentType = opponentType[base + n % N];
+            l.opponentOffset = opponentOffset[base + n % N];
+            sf::FloatRect car = l.opponentRect(p.pos, sprites.opponent[l.opponentType]);
+            if (car.width > 0 && playerRect.intersects(car)) return true;
+        }
+        return false;
+    }
+
+    void observe(int env, float* out) const {
+        out[OBS_LANE] = float(playerLane[env]);
+        out[OBS_PLAYER_X] = playerX[env];
+        out[OBS_SPEED] = speed[env] / 400.f;
+        out[OBS_BOOSTS_LEFT] = float(boostsLeft[env]);
+        out[OBS_BOOSTING] = isBoosting[env] ? 1.f : 0.f;
+        out[OBS_OVER] = isOver[env] ? 1.f : 0.f;
+
+        const int N = TRACK_SEGMENTS;
+        const std::int8_t* lanes = &opponentLane[std::size_t(env) * N];
+        const float range = float(OBSERVATION_RANGE * SEG_LEN);
+        int startPos = pos[env] / SEG_LEN;
+        bool seen[NUM_LANES] = {};
+        int found = 0;
+        for (int lane = 0; lane < NUM_LANES; lane++) out[OBS_LANE_AHEAD + lane] = 1;
+        out[OBS_NEXT_CAR] = 1;
+
+        for (int n = startPos; n < startPos + OBSERVATION_RANGE && found < NUM_LANES; n++) {
+            int lane = lanes[n % N];
+            if (lane < 0 || seen[lane]) continue;
+            float distance = std::max(0.f, float((n - startPos) * SEG_LEN - pos[env] % SEG_LEN)) / range;
+            out[OBS_LANE_AHEAD + lane] = distance;
+            if (found == 0) out[OBS_NEXT_CAR] = distance;
+            seen[lane] = true;
+            found++;
+        }
+    }
+
+    std::vector<Line> road;  // geometry only, shared by every environment
+    std::vector<float> viewMaxY;  // see buildViewMaxY
+    SpriteSizes sprites;
+    WorkerPool& pool;
+    int count;
+
+    // Player state, one entry per environment
+    std::vector<std::uint64_t> tickCount;
+    std::vector<int> pos;
+    std::vector<int> playerLane;
+    std::vector<float> playerX;
+    std::vector<float> targetX;
+    std::vector<int> score;
+    std::vector<int> speed;
+    std::vector<int> boostsLeft;
+    std::vector<int> boostTimer;
+    std::vector<std::uint8_t> isBoosting;
+    std::vector<std::uint8_t> isOver;
+    std::vector<unsigned> trackSeed;
+    std::vector<unsigned> trackGeneration;
+    std::vector<TrackRandom> random;  // opponents spawned during the race
+
+    // Opponents, TRACK_SEGMENTS entries per environment
+    std::vector<std::int8_t> opponentLane;  // -1 = no opponent
+    std::vector<std::uint8_t> opponentType;
+    std::vector<float> opponentOffset;
+};
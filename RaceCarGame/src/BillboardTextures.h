@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How billboard textures are prepared at load time
+struct MipmapSettings {
+    bool enabled = true;   // build a mip chain so far billboards sample a small level
+    int dropLevels = 0;    // skip this many of the largest levels to save memory
+};
+
+// Resident size of the billboard textures
+struct TextureMemory {
+    struct Entry {
+        std::string path;
+        std::uint64_t bytes;
+    };
+
+    std::uint64_t bytes = 0;
+    std::uint64_t fullSizeBytes = 0;  // what they would take at source size without mipmaps
+    int textures = 0;
+    std::vector<Entry> entries;       // one per texture, for the memory report
+
+    void add(const std::string& path, const sf::Texture& texture, sf::Vector2u sourceSize, bool mipmapped) {
+        std::uint64_t base = std::uint64_t(texture.getSize().x) * texture.getSize().y * 4;
+        std::uint64_t resident = mipmapped ? base * 4 / 3 : base;  // a full mip chain adds a third
+        bytes += resident;
+        fullSizeBytes += std::uint64_t(sourceSize.x) * sourceSize.y * 4;
+        textures++;
+        entries.push_back({ path, resident });
+    }
+};
+
+// Half-size copy with a 2x2 box filter. Color is weighted by alpha so the transparent
+// texels around a sprite don't bleed dark fringes into its edges.
+inline sf::Image halveImage(const sf::Image& source) {
+    sf::Vector2u size = source.getSize();
+    unsigned w = std::max(1u, size.x / 2), h = std::max(1u, size.y / 2);
+    sf::Image half;
+    half.create(w, h, sf::Color::Transparent);
+
+    for (unsigned y = 0; y < h; y++) {
+        for (unsigned x = 0; x < w; x++) {
+            unsigned r = 0, g = 0, b = 0, a = 0;
+            for (unsigned dy = 0; dy < 2; dy++) {
+                for (unsigned dx = 0; dx < 2; dx++) {
+                    sf::Color c = source.getPixel(std::min(x * 2 + dx, size.x - 1), std::min(y * 2 + dy, size.y - 1));
+                    r += c.r * c.a;
+                    g += c.g * c.a;
+                    b += c.b * c.a;
+                    a += c.a;
+                }
+            }
+            if (a > 0) half.setPixel(x, y, sf::Color(sf::Uint8(r / a), sf::Uint8(g / a), sf::Uint8(b / a), sf::Uint8(a / 4)));
+        }
+    }
+    return half;
+}
+
+// Load a texture that is mostly drawn minified. `sourceSize` is the image's size on
+// disk, which layout keeps using whatever level the texture starts at; the renderer
+// scales sprites by the texture's real size, so a dropped level only costs detail.
+inline bool loadBillboardTexture(sf::Texture& texture, sf::Vector2u& sourceSize, const std::string& path,
+    const MipmapSettings& settings, TextureMemory& memory) {
+    sf::Image image;
+    if (!image.loadFromFile(path)) return false;
+    sourceSize = image.getSize();
+
+    for (int i = 0; i < settings.dropLevels && image.getSize().x > 1 && image.getSize().y > 1; i++) {
+        image = halveImage(image);
+    }
+    if (!texture.loadFromImage(image)) return false;
+
+    texture.setSmooth(true);
+    bool mipmapped = settings.enabled && texture.generateMipmap();
+    memory.add(path, texture, sourceSize, mipmapped);
+    return true;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameConfig.h"
+#include "FrameSnapshot.h"
+
+// Opponent engine sounds. Every car in earshot gets a gain and pan each frame, computed
+// in one pass over the snapshot's engine sources; only the VOICES loudest are given a
+// real sf::Sound, the rest stay virtual and cost nothing but that arithmetic. However
+// dense the traffic, at most VOICES sounds ever play.
+class EngineVoices {
+public:
+    static const int VOICES = 4;
+
+    // Decode a short loop from the start of an engine recording, mixed down to mono so
+    // OpenAL can pan it. The end crossfades into the start so the loop has no click.
+    bool create(const std::string& path) {
+        sf::InputSoundFile file;
+        if (!file.openFromFile(path)) return false;
+
+        unsigned channels = file.getChannelCount();
+        unsigned rate = file.getSampleRate();
+        std::size_t loopFrames = std::size_t(rate * LOOP_SECONDS);
+        std::size_t fadeFrames = std::size_t(rate * FADE_SECONDS);
+
+        std::vector<sf::Int16> interleaved((loopFrames + fadeFrames) * channels);
+        std::size_t frames = std::size_t(file.read(interleaved.data(), interleaved.size()) / channels);
+        if (frames < loopFrames + fadeFrames) return false;
+
+        std::vector<sf::Int16> mono(loopFrames);
+        auto frameAt = [&](std::size_t f) {
+            int sum = 0;
+            for (unsigned c = 0; c < channels; c++) sum += interleaved[f * channels + c];
+            return float(sum) / channels;
+        };
+        for (std::size_t f = 0; f < loopFrames; f++) {
+            float sample = frameAt(f);
+            if (f < fadeFrames) {
+                float t = float(f) / fadeFrames;
+                sample = sample * t + frameAt(loopFrames + f) * (1 - t);
+            }
+            mono[f] = sf::Int16(sample);
+        }
+        if (!loop.loadFromSamples(mono.data(), mono.size(), 1, rate)) return false;
+
+        for (int i = 0; i < VOICES; i++) {
+            voices[i].setBuffer(loop);
+            voices[i].setLoop(true);
+            voices[i].setRelativeToListener(true);
+            voices[i].setAttenuation(0);  // distance falloff is ours, OpenAL only pans
+            voiceId[i] = -1;
+        }
+        created = true;
+        return true;
+    }
+
+    void update(const FrameSnapshot& frame) {
+        if (!created) return;
+        if (frame.isOver) {
+            silence();
+            return;
+        }
+
+        // Gain and pan for every source
+        int count = std::min(int(frame.engines.size()), OPPONENT_AUDIO_SEGMENTS);
+        const float range = float(OPPONENT_AUDIO_SEGMENTS * SEG_LEN);
+        for (int i = 0; i < count; i++) {
+            const EngineSource& s = frame.engines[i];
+            float falloff = REFERENCE_DISTANCE / (REFERENCE_DISTANCE + s.distance);
+            float edge = std::max(0.f, 1 - s.distance / range);  // fade out at the edge of earshot
+            gain[i] = falloff * edge;
+            pan[i] = std::max(-1.f, std::min(1.f, s.lateral * PAN_SPREAD));
+        }
+
+        // The VOICES loudest, kept sorted loudest first
+        int loudest[VOICES];
+        int picked = 0;
+        for (int i = 0; i < count; i++) {
+            if (gain[i] < MIN_GAIN || (picked == VOICES && gain[i] <= gain[loudest[VOICES - 1]])) continue;
+            int at = picked < VOICES ? picked++ : VOICES - 1;
+            while (at > 0 && gain[loudest[at - 1]] < gain[i]) {
+                loudest[at] = loudest[at - 1];
+                at--;
+            }
+            loudest[at] = i;
+        }
+        audibleTotal += std::uint64_t(picked);
+        virtualTotal += std::uint64_t(count - picked);
+        frames++;
+
+        // Cars that were already playing keep their voice, so their loop doesn't restart
+        bool taken[VOICES] = {};
+        int voiceFor[VOICES];
+        for (int k = 0; k < picked; k++) {
+            voiceFor[k] = -1;
+            for (int v = 0; v < VOICES; v++) {
+                if (!taken[v] && voiceId[v] == frame.engines[loudest[k]].id) {
+                    voiceFor[k] = v;
+                    taken[v] = true;
+                    break;
+                }
+            }
+        }
+        for (int k = 0; k < picked; k++) {
+            if (voiceFor[k] >= 0) continue;
+            for (int v = 0; v < VOICES; v++) {
+                if (!taken[v]) {
+                    voiceFor[k] = v;
+                    taken[v] = true;
+                    break;
+                }
+            }
+        }
+
+        for (int v = 0; v < VOICES; v++) {
+            if (!taken[v] && voiceId[v] >= 0) {
+                voices[v].pause();
+                voiceId[v] = -1;
+            }
+        }
+        for (int k = 0; k < picked; k++) {
+            const EngineSource& s = frame.engines[loudest[k]];
+            sf::Sound& voice = voices[voiceFor[k]];
+            float p = pan[loudest[k]];
+            voice.setVolume(MAX_VOLUME * gain[loudest[k]]);
+            voice.setPitch(s.type == 0 ? 1.0f : 1.12f);
+            voice.setPosition(p, 0, -std::sqrt(1 - p * p));
+            if (voiceId[voiceFor[k]] != s.id) {
+                voiceId[voiceFor[k]] = s.id;
+                voice.play();
+            }
+        }
+    }
+
+    void silence() {
+        for (int v = 0; v < VOICES; v++) {
+            if (voiceId[v] >= 0) voices[v].pause();
+            voiceId[v] = -1;
+        }
+    }
+
+    std::uint64_t loopBytes() const { return loop.getSampleCount() * sizeof(sf::Int16); }
+    float averageAudible() const { return frames ? float(audibleTotal) / frames : 0.f; }
+    float averageVirtual() const { return frames ? float(virtualTotal) / frames : 0.f; }
+
+private:
+    static constexpr float LOOP_SECONDS = 1.5f;
+    static constexpr float FADE_SECONDS = 0.05f;
+    static constexpr float REFERENCE_DISTANCE = SEG_LEN * 10.f;  // gain halves this far away
+    static constexpr float PAN_SPREAD = 1.2f;   // one lane over is panned well to the side
+    static constexpr float MIN_GAIN = 0.02f;    // quieter than this is not worth a voice
+    static constexpr float MAX_VOLUME = 60.f;   // below the player's own engine
+
+    sf::SoundBuffer loop;
+    sf::Sound voices[VOICES];
+    int voiceId[VOICES] = {};                   // source id on each voice, -1 = idle
+    bool created = false;
+
+    float gain[OPPONENT_AUDIO_SEGMENTS] = {};
+    float pan[OPPONENT_AUDIO_SEGMENTS] = {};
+
+    std::uint64_t audibleTotal = 0;
+    std::uint64_t virtualTotal = 0;
+    std::uint64_t frames = 0;
+};
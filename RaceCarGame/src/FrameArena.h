@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Bump allocator for data that only lives for one frame (or one simulation tick).
+// Memory is reserved once up front; reset() at the start of every frame makes it all reusable.
+// Only use it for types that don't need their destructor run.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t bytes) : buffer(new unsigned char[bytes]), capacity(bytes) {}
+
+    // Returns nullptr when the arena is exhausted
+    template <typename T>
+    T* allocate(std::size_t count) {
+        std::size_t start = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (start + sizeof(T) * count > capacity) return nullptr;
+        used = start + sizeof(T) * count;
+        if (used > highWater) highWater = used;
+        return reinterpret_cast<T*>(buffer.get() + start);
+    }
+
+    void reset() { used = 0; }
+
+    std::size_t bytesUsed() const { return used; }
+    std::size_t peakBytes() const { return highWater; }
+    std::size_t capacityBytes() const { return capacity; }
+
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    std::size_t highWater = 0;
+};
+
+// Fixed-capacity array carved out of a FrameArena; push_back drops items once full
+template <typename T>
+class ArenaVector {
+public:
+    ArenaVector() {}
+    ArenaVector(FrameArena& arena, std::size_t maxItems)
+        : items(arena.allocate<T>(maxItems)), maxCount(items ? maxItems : 0) {}
+
+    bool push_back(const T& value) {
+        if (count == maxCount) return false;
+        new (items + count) T(value);
+        count++;
+        return true;
+    }
+
+    T* data() { return items; }
+    const T* data() const { return items; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+private:
+    T* items = nullptr;
+    std::size_t count = 0;
+    std::size_t maxCount = 0;
+};
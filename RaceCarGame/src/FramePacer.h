@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// Holds a steady frame rate more precisely than RenderWindow::setFramerateLimit.
+// The OS sleep is only trusted to within SPIN_MARGIN; the rest of the wait is a spin
+// on the high-resolution clock, so frames start within microseconds of their deadline.
+class FramePacer {
+public:
+    explicit FramePacer(double framesPerSecond)
+        : period(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond))),
+          deadline(clock::now()) {}
+
+    // Block until the next frame should start
+    void wait() {
+        deadline += period;
+        clock::time_point now = clock::now();
+        if (now >= deadline) {
+            // Missed it: start the next frame now instead of running a burst to catch up
+            if (now - deadline > period) missedFrames++;
+            deadline = now;
+            return;
+        }
+
+        if (deadline - now > SPIN_MARGIN) {
+            std::this_thread::sleep_for(deadline - now - SPIN_MARGIN);
+        }
+        while (clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Start counting from now, e.g. after the loop slept in waitEvent on purpose
+    void resync() { deadline = clock::now(); }
+
+    std::uint64_t missedFrameCount() const { return missedFrames; }
+
+private:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::chrono::microseconds SPIN_MARGIN{ 1500 };
+
+    clock::duration period;
+    clock::time_point deadline;
+    std::uint64_t missedFrames = 0;
+};
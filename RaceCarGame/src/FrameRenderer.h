@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include "GameConfig.h"
+#include "FrameArena.h"
+#include "FrameSnapshot.h"
+
+// What one rendered frame cost the backend
+struct RenderStats {
+    int drawCalls = 0;
+    std::uint64_t vertices = 0;
+};
+
+// Where the pieces of a frame go. The SFML window and the software rasterizer both
+// implement this, so every backend draws exactly what renderFrame lays out.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    virtual void clear(sf::Color color) = 0;
+    virtual void drawBackground(float playerX) = 0;
+    virtual void drawTriangles(const sf::Vertex* vertices, std::size_t count) = 0;
+    virtual void drawFarScenery(const FrameSnapshot& frame) = 0;
+    virtual void drawBillboard(const Billboard& billboard) = 0;
+    virtual void fillRect(sf::FloatRect rect, sf::Color color) = 0;
+    virtual void drawPlayer(sf::Vector2f position, float rotation) = 0;
+    virtual void drawHud(const FrameSnapshot& frame) = 0;
+
+    RenderStats stats;  // reset by renderFrame
+};
+
+const sf::Color SKY_COLOR(135, 206, 235);
+const std::size_t MAX_ROAD_VERTICES = VIEW_SEGMENTS * 5 * 6; // grass, rumble, road, 2 lane marks
+const sf::Vector2f PLAYER_SIZE(120, 90);
+
+// Left edge of the shown part of a panorama `width` pixels wide
+inline int panoramaPan(int width, float playerX) {
+    float maxPan = float(std::max(0, width - WIDTH));
+    return int((playerX * 0.5f + 0.5f) * maxPan);
+}
+
+// Add one segment of road as a quad (two triangles) to the frame's road batch
+inline void drawQuad(ArenaVector<sf::Vertex>& batch, sf::Color c, int x1, int y1, int w1, int x2, int y2, int w2) {
+    sf::Vertex a(sf::Vector2f(float(x1 - w1), float(y1)), c);
+    sf::Vertex b(sf::Vector2f(float(x2 - w2), float(y2)), c);
+    sf::Vertex d(sf::Vector2f(float(x2 + w2), float(y2)), c);
+    sf::Vertex e(sf::Vector2f(float(x1 + w1), float(y1)), c);
+    batch.push_back(a);
+    batch.push_back(b);
+    batch.push_back(d);
+    batch.push_back(a);
+    batch.push_back(d);
+    batch.push_back(e);
+}
+
+// Draw one gameplay frame from a snapshot; `arena` must have room for the road batch
+inline void renderFrame(const FrameSnapshot& frame, RenderBackend& backend, FrameArena& arena) {
+    backend.stats = RenderStats();
+
+    // Clear window
+    backend.clear(SKY_COLOR);  // Sky blue
+
+    // Draw panoramic background
+    backend.drawBackground(frame.playerX);
+
+    // Batch all road quads into one draw call
+    ArenaVector<sf::Vertex> roadBatch(arena, MAX_ROAD_VERTICES);
+    for (const RoadSegment& s : frame.segments) {
+        // Less intense grass color (reduced green intensity)
+        sf::Color grass = s.isDark ? sf::Color(0, 120, 0) : sf::Color(0, 135, 0); // Reduced from 154/170 to 120/135
+
+        drawQuad(roadBatch, grass, 0, int(s.y1), WIDTH, 0, int(s.y2), WIDTH);
+
+        // Draw road shoulder
+        sf::Color rumble = s.isDark ? sf::Color(170, 0, 0) : sf::Color(255, 255, 255);
+        drawQuad(roadBatch, rumble, int(s.x1), int(s.y1), int(s.w1 * 1.15f), int(s.x2), int(s.y2), int(s.w2 * 1.15f)); // Reduced from 1.2f
+
+        // Draw road
+        sf::Color road = s.isDark ? sf::Color(70, 70, 70) : sf::Color(80, 80, 80);
+        drawQuad(roadBatch, road, int(s.x1), int(s.y1), int(s.w1), int(s.x2), int(s.y2), int(s.w2));
+
+        // Draw shorter lane markings for corner strips
+        if (s.laneMarks) { // Only draw if road is wide enough
+            float laneW1 = s.w1 * 2.0f / NUM_LANES;
+            float laneW2 = s.w2 * 2.0f / NUM_LANES;
+            float laneX1 = s.x1 - s.w1;
+            float laneX2 = s.x2 - s.w2;
+
+            // Shorter lane markings (reduced width from 2 to 1)
+            int markingWidth = std::max(1, int(s.w1 * LANE_MARK_WIDTH)); // Adaptive width based on distance
+            for (int lane = 1; lane < NUM_LANES; lane++) {
+                drawQuad(roadBatch, sf::Color::White,
+                    int(laneX1 + laneW1 * lane), int(s.y1), markingWidth,
+                    int(laneX2 + laneW2 * lane), int(s.y2), markingWidth);
+            }
+        }
+    }
+    backend.drawTriangles(roadBatch.data(), roadBatch.size());
+
+    // Draw far scenery behind everything near
+    backend.drawFarScenery(frame);
+
+    // Draw near scenery, opponent shadows and opponents
+    for (const Billboard& b : frame.billboards) {
+        if (b.kind == SHADOW_BILLBOARD) backend.fillRect(b.rect, b.color);
+        else backend.drawBillboard(b);
+    }
+
+    // Draw player car with better grounding
+    float playerScreenX = WIDTH / 2 + frame.playerX * WIDTH / 3;
+
+    // Add more realistic shadow under player car
+    backend.fillRect(sf::FloatRect(playerScreenX - 55, HEIGHT - 65, 110, 12), sf::Color(0, 0, 0, 140)); // Shadow positioned on road surface
+
+    // Reduced tilt effect for smoother animation
+    float tilt = (frame.targetX - frame.playerX) * 15;
+    backend.drawPlayer(sf::Vector2f(playerScreenX, HEIGHT - 110), tilt); // Adjusted to sit better on road
+
+    // Draw UI
+    backend.drawHud(frame);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+
+// What a billboard is drawn with
+enum BillboardKind { SCENERY_BILLBOARD, OPPONENT_BILLBOARD, SHADOW_BILLBOARD };
+
+// One screen-space sprite produced by the simulation for the renderer
+struct Billboard {
+    BillboardKind kind = SCENERY_BILLBOARD;
+    int texture = 0;                 // index into the scenery or opponent texture table
+    sf::FloatRect rect;              // destination rectangle in screen pixels
+    sf::Color color = sf::Color::White; // fill color for shadows
+};
+
+// An opponent close enough to be heard, taken from the same lane and z data as its billboard
+struct EngineSource {
+    int id = 0;                      // track segment the car sits on; stable while it is in range
+    int type = 0;                    // opponent texture, also picks the engine pitch
+    float lateral = 0;               // road half-widths right of the player (negative = left)
+    float distance = 0;              // world units ahead of the player
+};
+
+// One projected road segment: previous line (1) to current line (2)
+struct RoadSegment {
+    float x1 = 0, y1 = 0, w1 = 0;
+    float x2 = 0, y2 = 0, w2 = 0;
+    bool isDark = false;             // alternating segment colors
+    bool laneMarks = false;          // wide enough to draw lane markings
+};
+
+// Immutable render input published by the simulation thread once per tick.
+// The renderer only reads from it; nothing in here points back into the simulation.
+struct FrameSnapshot {
+    std::uint64_t tick = 0;          // 0 means nothing has been published yet
+
+    // Camera
+    int pos = 0;
+    float playerX = 0;
+    float targetX = 0;
+
+    // Projected road, far segments last
+    std::vector<RoadSegment> segments;
+    int projectedSegments = 0;       // track lines projected this tick (stops at the horizon)
+    int mergedSegments = 0;          // sub-pixel lines folded into a neighbour's quad
+    // Scenery, shadows and opponents in draw order
+    std::vector<Billboard> billboards;
+    // Scenery past the impostor split distance
+    std::vector<Billboard> farBillboards;
+    // Which segments farBillboards came from; changes whenever an object crosses the
+    // split or the end of the scenery range
+    std::uint64_t farSceneryKey = 0;
+    // Opponents within earshot, nearest first
+    std::vector<EngineSource> engines;
+
+    // HUD
+    int score = 0;
+    int speed = 0;
+    int boostsLeft = 0;
+    bool isBoosting = false;
+    bool isOver = false;
+
+    // Latest input that changed the game: sequence number and when the key was first seen
+    unsigned inputSeq = 0;
+    std::int64_t inputTimeUs = 0;
+
+    // Audio cues; each counter goes up once per event so dropped snapshots never lose one
+    unsigned boostCue = 0;
+    unsigned crashCue = 0;
+    unsigned restartCue = 0;
+
+    void reserve() {
+        segments.reserve(VIEW_SEGMENTS);
+        billboards.reserve(VIEW_SEGMENTS * 2);
+        farBillboards.reserve(VIEW_SEGMENTS);
+        engines.reserve(OPPONENT_AUDIO_SEGMENTS);
+    }
+
+    // Heap held by the lists, reserved or in use
+    std::uint64_t capacityBytes() const {
+        return segments.capacity() * sizeof(RoadSegment) + (billboards.capacity() + farBillboards.capacity()) * sizeof(Billboard)
+            + engines.capacity() * sizeof(EngineSource);
+    }
+};
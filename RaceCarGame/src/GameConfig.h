@@ -0,0 +1,30 @@
+#pragma once
+
+// Window dimensions
+const int WIDTH = 1024;
+const int HEIGHT = 768;
+
+// Road parameters
+const int ROAD_W = 2500;  // Increased road width (was 2000)
+const int SEG_LEN = 200;   // Segment length
+const float CAM_D = 0.84f;  // Camera depth
+
+const int NUM_LANES = 3;
+
+// Simulation parameters
+const int SIM_TICK_HZ = 60;      // Fixed simulation rate, independent of the render rate
+const int TRACK_SEGMENTS = 1600; // Total segments
+const int VIEW_SEGMENTS = 800;   // Segments projected every frame (fewer once the horizon is reached)
+const int OPPONENT_DRAW_SEGMENTS = 300; // Segments that get opponents
+const int OPPONENT_AUDIO_SEGMENTS = 120; // Opponents this close can be heard
+
+// Road level of detail
+const float LOD_MERGE_HEIGHT = 1.0f;     // Consecutive segments flatter than this (pixels) become one quad
+const float LANE_MARK_WIDTH = 0.005f;    // Lane marking width as a fraction of the road half-width
+const float LANE_MARK_MIN_WIDTH = 0.25f; // Lane markings narrower than this (pixels) are skipped
+
+// Game states
+enum GameState { MENU, CAR_SELECTION, PLAYING, GAME_OVER_PROMPT };
+
+// Car types
+enum CarType { NORMAL_CAR, POLICE_CAR };
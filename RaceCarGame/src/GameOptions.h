@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Settings picked on the command line, e.g. --impostor-split=60
+struct GameOptions {
+    int impostorSplitSegments = 45;  // scenery further than this is drawn from the impostor (0 = off)
+    int impostorRefreshTicks = 3;    // re-render the impostor at least this often
+    float frameBudgetMs = 16.6f;     // quality governor target (0 = fixed quality)
+    int qualityLevel = -1;           // starting quality level (-1 = highest)
+    float framesPerSecond = 60;      // render frame pacing target
+    bool lateInput = false;          // simulation samples steering keys itself, just before each step
+    bool showProfiler = false;       // start with the F3 profiler overlay open
+    unsigned seed = 0;               // track seed (0 = from the clock)
+    std::string recordInputPath;     // save every input event here at exit
+    std::string replayInputPath;     // play input back from a recording instead of the keyboard
+    long headlessTicks = -1;         // run this many ticks without a window (0 = length of the replay)
+    bool checkAllocations = false;   // ... and fail if a tick allocates once warmed up
+    bool mipmaps = true;             // mipmap billboard textures
+    int mipDropLevels = 0;           // load billboard textures this many levels below full size
+    bool benchSampling = false;      // run the billboard sampling benchmark and exit
+    bool softwareRenderer = false;   // rasterize frames on the CPU instead of through OpenGL
+    std::string dumpFramesDir;       // headless runs: save rendered frames here as PNG
+    int dumpEveryTicks = 60;         // ... one every this many ticks
+    std::string goldenDir;           // check rendered frames and budgets against this golden set and exit
+    bool updateGolden = false;       // ... or rewrite the golden set from this run
+    std::string goldenOutDir = ".";  // ... writing frames that don't match here
+    int batchEnvs = 0;               // run this many games in lockstep as a benchmark and exit (0 = off)
+    int batchSteps = 3600;           // ... for this many ticks
+    int threads = 0;                 // worker threads for batch jobs (0 = one per core)
+    int benchTrackSegments = 0;      // generate a track this long as a benchmark and exit (0 = off)
+    bool stressScene = false;        // opponents and scenery on every segment, full view distance, no crashes
+    std::string error;               // options that can't be used together; nothing should run
+};
+
+inline GameOptions parseOptions(int argc, char** argv) {
+    GameOptions options;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = std::strchr(arg, '=');
+        std::size_t nameLen = value ? std::size_t(value - arg) : std::strlen(arg);
+        if (value) value++;
+
+        auto is = [&](const char* name) { return std::strlen(name) == nameLen && std::strncmp(arg, name, nameLen) == 0; };
+
+        if (is("--impostor-split") && value) {
+            options.impostorSplitSegments = std::max(0, std::atoi(value));
+        }
+        else if (is("--impostor-refresh") && value) {
+            options.impostorRefreshTicks = std::max(1, std::atoi(value));
+        }
+        else if (is("--frame-budget") && value) {
+            options.frameBudgetMs = float(std::max(0.0, std::atof(value)));
+        }
+        else if (is("--quality") && value) {
+            options.qualityLevel = std::atoi(value);
+        }
+        else if (is("--fps") && value) {
+            options.framesPerSecond = float(std::max(10.0, std::atof(value)));
+        }
+        else if (is("--late-input")) {
+            options.lateInput = true;
+        }
+        else if (is("--profiler")) {
+            options.showProfiler = true;
+        }
+        else if (is("--seed") && value) {
+            options.seed = unsigned(std::strtoul(value, nullptr, 10));
+        }
+        else if (is("--record-input") && value) {
+            options.recordInputPath = value;
+        }
+        else if (is("--replay-input") && value) {
+            options.replayInputPath = value;
+        }
+        else if (is("--no-mipmaps")) {
+            options.mipmaps = false;
+        }
+        else if (is("--mip-drop") && value) {
+            options.mipDropLevels = std::max(0, std::atoi(value));
+        }
+        else if (is("--bench-sampling")) {
+            options.benchSampling = true;
+        }
+        else if (is("--renderer") && value) {
+            if (std::strcmp(value, "software") == 0) options.softwareRenderer = true;
+            else if (std::strcmp(value, "sfml") == 0) options.softwareRenderer = false;
+            else std::cerr << "Warning: unknown renderer " << value << std::endl;
+        }
+        else if (is("--dump-frames") && value) {
+            options.dumpFramesDir = value;
+        }
+        else if (is("--dump-every") && value) {
+            options.dumpEveryTicks = std::max(1, std::atoi(value));
+        }
+        else if (is("--golden") && value) {
+            options.goldenDir = value;
+        }
+        else if (is("--update-golden")) {
+            options.updateGolden = true;
+        }
+        else if (is("--golden-out") && value) {
+            options.goldenOutDir = value;
+        }
+        else if (is("--batch") && value) {
+            options.batchEnvs = std::max(0, std::atoi(value));
+        }
+        else if (is("--batch-steps") && value) {
+            options.batchSteps = std::max(1, std::atoi(value));
+        }
+        else if (is("--threads") && value) {
+            options.threads = std::max(0, std::atoi(value));
+        }
+        else if (is("--bench-track") && value) {
+            options.benchTrackSegments = std::max(0, std::atoi(value));
+        }
+        else if (is("--stress")) {
+            options.stressScene = true;
+        }
+        else if (is("--headless")) {
+            options.headlessTicks = value ? std::max(0L, std::atol(value)) : 0;
+        }
+        else if (is("--check-allocations")) {
+            options.checkAllocations = true;
+        }
+        else {
+            std::cerr << "Warning: unknown option " << arg << std::endl;
+        }
+    }
+    // Replays and headless runs must not read the live keyboard
+    if (!options.replayInputPath.empty() || options.headlessTicks >= 0 || !options.goldenDir.empty()) options.lateInput = false;
+    // A golden set fixes the scene; anything that changes it would compare against, or
+    // overwrite, the goldens with a different game
+    if (!options.goldenDir.empty() || options.updateGolden) {
+        if (options.stressScene) options.error = "--stress can't be used with --golden or --update-golden";
+        else if (options.batchEnvs > 0) options.error = "--batch can't be used with --golden or --update-golden";
+        else if (options.benchSampling || options.benchTrackSegments > 0) {
+            options.error = "--bench-sampling and --bench-track can't be used with --golden or --update-golden";
+        }
+    }
+    // The stress scene is a worst case: the governor must not thin it out
+    if (options.stressScene) options.frameBudgetMs = 0;
+    return options;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "GameConfig.h"
+#include "Track.h"
+
+const int MAX_BOOSTS = 3;
+
+// Everything about the player that one tick of the rules reads and writes. Simulation
+// keeps one; BatchSimulation keeps the same fields as arrays and loads one at a time.
+struct PlayerState {
+    int pos = 0;
+    int playerLane = 1;  // Middle lane (0=left, 1=middle, 2=right)
+    float playerX = 0;
+    float targetX = 0;
+    int score = 0;
+    int speed = 0;
+
+    // Boost system
+    int boostsLeft = MAX_BOOSTS;
+    int boostTimer = 0;
+    bool isBoosting = false;
+
+    bool isOver = false;
+};
+
+// One key press, as the game understands it
+enum PlayerAction { ACTION_NONE, ACTION_LEFT, ACTION_RIGHT, ACTION_BOOST, ACTION_RESTART };
+
+// Apply a press during a race; returns whether it changed anything. Restarting also
+// re-places the opponents, so that is left to the owner of the track.
+inline bool applyAction(PlayerState& p, PlayerAction action) {
+    if (p.isOver) return false;
+    // Each press is one lane change, so two taps inside one tick move two lanes
+    if (action == ACTION_LEFT && p.playerLane > 0) {
+        p.playerLane--;
+        return true;
+    }
+    if (action == ACTION_RIGHT && p.playerLane < NUM_LANES - 1) {
+        p.playerLane++;
+        return true;
+    }
+    if (action == ACTION_BOOST && p.boostsLeft > 0 && !p.isBoosting) {
+        p.isBoosting = true;
+        p.boostTimer = 0;
+        p.boostsLeft--;
+        return true;
+    }
+    return false;
+}
+
+inline void resetPlayer(PlayerState& p) {
+    p.isOver = false;
+    p.pos = 0;
+    p.playerLane = 1;  // Start in middle lane
+    p.playerX = 0;
+    p.targetX = 0;
+    p.score = 0;
+    p.boostsLeft = MAX_BOOSTS;
+    p.isBoosting = false;
+    p.boostTimer = 0;
+}
+
+// Steering, boost and distance for one tick on a track `segments` long
+inline void advancePlayer(PlayerState& p, int segments) {
+    // Lane changes were applied by handleInput, one per key press
+    // Calculate target position based on current lane
+    // Lane 0 = -0.6, Lane 1 = 0, Lane 2 = 0.6
+    p.targetX = (p.playerLane - 1) * 0.6f;
+
+    // Smooth transition to target position
+    p.playerX += (p.targetX - p.playerX) * 0.15f;
+
+    // Update speed and position
+    if (p.isBoosting) {
+        p.speed = 400;
+        p.boostTimer++;
+        if (p.boostTimer > 120) {  // 2 seconds boost
+            p.isBoosting = false;
+            p.boostTimer = 0;
+        }
+    }
+    else {
+        p.speed = 200;
+    }
+
+    p.pos += p.speed;
+    while (p.pos >= segments * SEG_LEN) p.pos -= segments * SEG_LEN;
+    while (p.pos < 0) p.pos += segments * SEG_LEN;
+
+    p.score = p.pos / 100;
+}
+
+// Dynamically spawn more opponents as game progresses. `hasOpponent(i)` and
+// `place(i)` look at and fill segment i; place must draw from `r` like placeOpponent.
+template <typename HasOpponent, typename Place>
+inline void spawnOpponents(const PlayerState& p, int segments, TrackRandom& r, HasOpponent hasOpponent, Place place) {
+    const int N = segments;
+    if (p.score > 50 && p.score % 100 == 0) { // Every 100 points after score 50
+        for (int i = (p.pos / SEG_LEN) + 500; i < (p.pos / SEG_LEN) + 700; i += 100 + r.dist_spawn(r.rng) % 150) {
+            if (i < N && !hasOpponent(i % N) && r.dist_spawn(r.rng) % 100 < 30) { // 30% chance
+                place(i % N);
+            }
+        }
+    }
+}
+
+// The player car's screen rectangle, which opponents in its lane must not touch
+inline sf::FloatRect playerCollisionRect(float playerX) {
+    float playerScreenX = WIDTH / 2 + playerX * WIDTH / 3;
+    float playerScreenY = HEIGHT - 110;
+    return sf::FloatRect(playerScreenX - 60, playerScreenY - 45, 120, 90);
+}
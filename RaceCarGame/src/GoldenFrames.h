@@ -0,0 +1,257 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FrameArena.h"
+#include "FrameRenderer.h"
+#include "FrameSnapshot.h"
+#include "GameOptions.h"
+#include "Headless.h"
+#include "InputLog.h"
+#include "InputQueue.h"
+#include "Simulation.h"
+#include "SoftwareRenderer.h"
+
+// What a golden directory promises, kept in DIR/golden.txt:
+//   frames 60 180 300         ticks compared against DIR/frame_<tick>.png
+//   tolerance 12 0.002        per-pixel colour distance, fraction of pixels allowed over it
+//   max-draw-calls 16         worst frame of the run
+//   max-vertices 1650
+//   max-avg-cpu-ms 6.5        optional: software render time per frame, averaged over the run
+// The run itself is DIR/input.txt, an InputLog, so seed and input are fixed. Render time
+// depends on the machine, so a committed set leaves max-avg-cpu-ms out (or 0) and only
+// reports it; add the line locally to hold one machine to a budget.
+struct GoldenSpec {
+    std::vector<std::uint64_t> frames;
+    float pixelTolerance = 12;
+    double maxBadFraction = 0.002;
+    int maxDrawCalls = 0;
+    std::uint64_t maxVertices = 0;
+    double maxAvgCpuMs = 0;          // 0: not checked
+
+    bool save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) return false;
+        file << "frames";
+        for (std::uint64_t t : frames) file << " " << t;
+        file << "\ntolerance " << pixelTolerance << " " << maxBadFraction << "\n"
+             << "max-draw-calls " << maxDrawCalls << "\n"
+             << "max-vertices " << maxVertices << "\n";
+        if (maxAvgCpuMs > 0) file << "max-avg-cpu-ms " << maxAvgCpuMs << "\n";
+        return bool(file);
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            std::string key;
+            if (!(words >> key)) continue;
+            if (key == "frames") {
+                frames.clear();
+                std::uint64_t t;
+                while (words >> t) frames.push_back(t);
+            }
+            else if (key == "tolerance") words >> pixelTolerance >> maxBadFraction;
+            else if (key == "max-draw-calls") words >> maxDrawCalls;
+            else if (key == "max-vertices") words >> maxVertices;
+            else if (key == "max-avg-cpu-ms") words >> maxAvgCpuMs;
+            else return false;
+        }
+        return !frames.empty();
+    }
+};
+
+// Colour distance between two pixels on a 0-255 scale, weighted the way the eye is
+// more sensitive to green and to red in warm colours ("redmean")
+inline float perceptualDistance(const sf::Uint8* a, const sf::Uint8* b) {
+    float rMean = (a[0] + b[0]) * 0.5f;
+    float dr = float(a[0]) - b[0], dg = float(a[1]) - b[1], db = float(a[2]) - b[2];
+    float d = (2 + rMean / 256) * dr * dr + 4 * dg * dg + (2 + (255 - rMean) / 256) * db * db;
+    return std::sqrt(d / 9);
+}
+
+struct FrameComparison {
+    std::uint64_t badPixels = 0;
+    float worstDistance = 0;
+};
+
+// Compare a rendered frame with its golden and fill `diff` with a picture of where they
+// differ: the golden dimmed, pixels over the tolerance in red
+inline FrameComparison compareFrame(const Framebuffer& frame, const sf::Image& golden, float tolerance, sf::Image& diff) {
+    FrameComparison result;
+    const sf::Uint8* a = frame.pixels();
+    const sf::Uint8* b = golden.getPixelsPtr();
+    std::size_t count = std::size_t(frame.width()) * frame.height();
+    diff.create(unsigned(frame.width()), unsigned(frame.height()));
+    for (std::size_t i = 0; i < count; i++) {
+        float d = perceptualDistance(a + i * 4, b + i * 4);
+        result.worstDistance = std::max(result.worstDistance, d);
+        unsigned x = unsigned(i % frame.width()), y = unsigned(i / frame.width());
+        if (d > tolerance) {
+            result.badPixels++;
+            diff.setPixel(x, y, sf::Color::Red);
+        }
+        else {
+            sf::Uint8 grey = sf::Uint8((b[i * 4] + b[i * 4 + 1] + b[i * 4 + 2]) / 12);
+            diff.setPixel(x, y, sf::Color(grey, grey, grey));
+        }
+    }
+    return result;
+}
+
+// --golden=DIR: replay DIR/input.txt through the software renderer, compare the listed
+// ticks with the stored images and check the run against the draw-call, vertex and CPU
+// budgets. Exits non-zero on any failure; mismatching frames are written as .actual.png
+// and .diff.png to --golden-out (the working directory by default), never into the
+// golden set itself. With --update-golden the images and budgets are
+// rewritten from this run instead (input.txt comes from --replay-input, or --seed and
+// --headless=TICKS with no input, when the directory has none yet).
+inline int runGoldenFrames(const GameOptions& options) {
+    const std::string dir = options.goldenDir;
+    const std::string inputPath = dir + "/input.txt";
+    const std::string specPath = dir + "/golden.txt";
+    const bool update = options.updateGolden;
+
+    InputLog replay;
+    if (!options.replayInputPath.empty()) {
+        if (!replay.load(options.replayInputPath)) {
+            std::cerr << "Error: could not read input recording " << options.replayInputPath << std::endl;
+            return 1;
+        }
+    }
+    else if (!replay.load(inputPath)) {
+        if (!update || options.headlessTicks <= 0) {
+            std::cerr << "Error: " << inputPath << " is missing; create it with --update-golden and "
+                "--replay-input=FILE or --seed=N --headless=TICKS" << std::endl;
+            return 1;
+        }
+        replay = InputLog();
+        replay.seed = options.seed;
+        replay.ticks = std::uint64_t(options.headlessTicks);
+    }
+
+    GoldenSpec spec;
+    bool haveSpec = spec.load(specPath);
+    if (!haveSpec && !update) {
+        std::cerr << "Error: could not read " << specPath << std::endl;
+        return 1;
+    }
+    std::sort(spec.frames.begin(), spec.frames.end());
+
+    Simulation sim(replay.seed, loadSpriteSizes(), options);
+    InputQueue input;
+    input.play(&replay.events);
+
+    SoftwareBackend renderer;
+    if (!renderer.load("images/car.png")) std::cerr << "Warning: some images could not be loaded" << std::endl;
+    FrameArena arena(1024 * 1024);
+
+    FrameSnapshot frame;
+    frame.reserve();
+    double renderMs = 0;
+    std::uint64_t renderedFrames = 0, worstVertices = 0;
+    int worstDrawCalls = 0;
+    std::size_t nextGolden = 0;
+    int failures = 0;
+
+    for (std::uint64_t t = 0; t < replay.ticks; t++) {
+        sim.tick(frame, input, 0);
+        // A new golden set takes one frame every --dump-every ticks while the race is on
+        bool wanted = haveSpec ? nextGolden < spec.frames.size() && spec.frames[nextGolden] == frame.tick
+                               : !frame.isOver && frame.tick % options.dumpEveryTicks == 0;
+        if (frame.isOver) {
+            if (wanted) {
+                std::cerr << "FAIL tick " << frame.tick << ": the run is already over" << std::endl;
+                failures++;
+                nextGolden++;
+            }
+            continue;
+        }
+
+        arena.reset();
+        auto renderStart = std::chrono::steady_clock::now();
+        renderFrame(frame, renderer, arena);
+        renderMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+        renderedFrames++;
+        worstDrawCalls = std::max(worstDrawCalls, renderer.stats.drawCalls);
+        worstVertices = std::max(worstVertices, renderer.stats.vertices);
+
+        if (!wanted) continue;
+        nextGolden++;
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "/frame_%06llu", (unsigned long long)frame.tick);
+        std::string goldenPath = dir + name + ".png";
+        if (update) {
+            if (!haveSpec) spec.frames.push_back(frame.tick);
+            if (!renderer.framebuffer().savePng(goldenPath)) {
+                std::cerr << "Error: could not write " << goldenPath << std::endl;
+                return 1;
+            }
+            continue;
+        }
+
+        sf::Image golden;
+        if (!golden.loadFromFile(goldenPath) || golden.getSize() != sf::Vector2u(unsigned(WIDTH), unsigned(HEIGHT))) {
+            std::cerr << "FAIL tick " << frame.tick << ": no usable golden " << goldenPath << std::endl;
+            failures++;
+            continue;
+        }
+        sf::Image diff;
+        FrameComparison result = compareFrame(renderer.framebuffer(), golden, spec.pixelTolerance, diff);
+        double badFraction = double(result.badPixels) / (double(WIDTH) * HEIGHT);
+        bool ok = badFraction <= spec.maxBadFraction;
+        std::cout << (ok ? "ok   " : "FAIL ") << "tick " << frame.tick << ": " << result.badPixels
+            << " pixels over tolerance (" << badFraction * 100 << "%), worst distance " << result.worstDistance << std::endl;
+        if (!ok) {
+            failures++;
+            renderer.framebuffer().savePng(options.goldenOutDir + name + ".actual.png");
+            diff.saveToFile(options.goldenOutDir + name + ".diff.png");
+        }
+    }
+    for (; nextGolden < spec.frames.size(); nextGolden++) {
+        std::cerr << "FAIL tick " << spec.frames[nextGolden] << ": past the end of the run" << std::endl;
+        failures++;
+    }
+
+    double avgMs = renderedFrames > 0 ? renderMs / renderedFrames : 0;
+    if (update) {
+        // Counts are exact, so any increase fails. A CPU budget is only kept if the set
+        // already had one, re-measured on this machine with headroom for noise.
+        spec.maxDrawCalls = worstDrawCalls;
+        spec.maxVertices = worstVertices;
+        if (spec.maxAvgCpuMs > 0) spec.maxAvgCpuMs = std::ceil(avgMs * 1.5 * 100) / 100;
+        if (!replay.save(inputPath) || !spec.save(specPath)) {
+            std::cerr << "Error: could not write " << dir << std::endl;
+            return 1;
+        }
+        std::cout << "Updated " << spec.frames.size() << " golden frames and budgets in " << dir << std::endl;
+        return failures > 0 ? 1 : 0;
+    }
+
+    auto budget = [&](const char* what, double value, double limit) {
+        bool ok = value <= limit;
+        std::cout << (ok ? "ok   " : "FAIL ") << what << " " << value << " (budget " << limit << ")" << std::endl;
+        if (!ok) failures++;
+    };
+    budget("max draw calls", worstDrawCalls, spec.maxDrawCalls);
+    budget("max vertices", double(worstVertices), double(spec.maxVertices));
+    if (spec.maxAvgCpuMs > 0) budget("avg render ms", avgMs, spec.maxAvgCpuMs);
+    else std::cout << "     avg render ms " << avgMs << " (no budget)" << std::endl;
+
+    std::cout << (failures == 0 ? "Golden frames passed" : "Golden frames FAILED") << " (" << spec.frames.size()
+        << " frames, " << failures << " failures)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
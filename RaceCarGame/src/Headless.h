@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include "AllocationCounter.h"
+#include "FrameArena.h"
+#include "FrameRenderer.h"
+#include "FrameSnapshot.h"
+#include "GameOptions.h"
+#include "InputLog.h"
+#include "InputQueue.h"
+#include "MemoryReport.h"
+#include "Simulation.h"
+#include "SoftwareRenderer.h"
+#include "Track.h"
+
+// Billboard sizes read from the image files, so the simulation can run without a
+// window or GL context. Layout and spawning match a windowed run with the same files.
+inline SpriteSizes loadSpriteSizes() {
+    SpriteSizes sizes;
+    sf::Image image;
+
+    const char* opponents[2] = { "images/8.png", "images/2nd.png" };
+    for (int i = 0; i < 2; i++) {
+        // Same fallback as the game: the player's car stands in for missing opponents
+        if (image.loadFromFile(opponents[i]) || image.loadFromFile("images/car.png")) {
+            sizes.opponent[i] = image.getSize();
+        }
+    }
+
+    const char* scenery[4] = { "images/4.png", "images/5.png", "images/7.png", "images/6.png" };
+    sizes.hasScenery = true;
+    for (int i = 0; i < 4; i++) {
+        if (image.loadFromFile(scenery[i])) sizes.scenery[i] = image.getSize();
+        else sizes.hasScenery = false;
+    }
+    return sizes;
+}
+
+// --headless: run the simulation as fast as it goes, fed from a recording (or with no
+// input at all), and print the end state so runs can be compared. With
+// --renderer=software every gameplay tick is also rendered on the CPU and timed.
+// --check-allocations fails the run if any tick allocates after warm-up (debug builds;
+// exits with 77, "skipped", where allocations aren't counted).
+inline int runHeadless(const GameOptions& options) {
+    InputLog replay;
+    if (!options.replayInputPath.empty() && !replay.load(options.replayInputPath)) {
+        std::cerr << "Error: could not read input recording " << options.replayInputPath << std::endl;
+        return 1;
+    }
+    bool replaying = !options.replayInputPath.empty();
+    unsigned seed = replaying ? replay.seed : options.seed;
+    std::uint64_t ticks = options.headlessTicks > 0 ? std::uint64_t(options.headlessTicks) : replay.ticks;
+    if (ticks == 0) {
+        std::cerr << "Error: --headless needs a tick count or an input recording" << std::endl;
+        return 1;
+    }
+
+    Simulation sim(seed, loadSpriteSizes(), options);
+    InputQueue input;
+    input.play(&replay.events);
+
+    InputLog recording;
+    if (!options.recordInputPath.empty()) sim.record(&recording);
+
+    // Only built when asked for: the framebuffer and image copies are several MB
+    std::unique_ptr<SoftwareBackend> renderer;
+    if (options.softwareRenderer) {
+        renderer.reset(new SoftwareBackend());
+        if (!renderer->load("images/car.png")) std::cerr << "Warning: some images could not be loaded" << std::endl;
+    }
+    FrameArena arena(1024 * 1024);
+    double renderMs = 0, worstRenderMs = 0;
+    std::uint64_t renderedFrames = 0, drawCalls = 0, vertices = 0, dumped = 0;
+
+    FrameSnapshot frame;
+    frame.reserve();
+    double seconds = 0;
+    // Same rule as the game loop: after a warm-up, and again after the race ends, a
+    // tick and its frame must not touch the heap
+    int warmupTicksLeft = ALLOCATION_WARMUP_FRAMES;
+    bool lastOver = false;
+    std::uint64_t steadyStateAllocations = 0;
+    for (std::uint64_t t = 0; t < ticks; t++) {
+        std::uint64_t allocationsAtTickStart = allocationCount();
+        std::uint64_t recordingGrowthsAtTickStart = sim.recordingGrowthCount();
+        auto tickStart = std::chrono::steady_clock::now();
+        sim.tick(frame, input, 0);
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count();
+
+        double ms = 0;
+        if (renderer && !frame.isOver) {
+            arena.reset();
+            auto renderStart = std::chrono::steady_clock::now();
+            renderFrame(frame, *renderer, arena);
+            ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+        }
+
+        if (frame.isOver != lastOver) {
+            lastOver = frame.isOver;
+            warmupTicksLeft = ALLOCATION_WARMUP_FRAMES;
+        }
+        if (warmupTicksLeft > 0) {
+            warmupTicksLeft--;
+        }
+        else {
+            // A growing input recording is expected to allocate
+            std::uint64_t allocations = allocationCount() - allocationsAtTickStart
+                - (sim.recordingGrowthCount() - recordingGrowthsAtTickStart);
+            if (allocations > 0 && steadyStateAllocations == 0) {
+                std::cerr << "Error: " << allocations << " heap allocations in a steady-state tick (tick " << frame.tick << ")" << std::endl;
+            }
+            steadyStateAllocations += allocations;
+        }
+
+        if (!renderer || frame.isOver) continue;
+        renderMs += ms;
+        worstRenderMs = std::max(worstRenderMs, ms);
+        renderedFrames++;
+        drawCalls += renderer->stats.drawCalls;
+        vertices += renderer->stats.vertices;
+
+        if (!options.dumpFramesDir.empty() && frame.tick % options.dumpEveryTicks == 0) {
+            char path[512];
+            std::snprintf(path, sizeof(path), "%s/frame_%06llu.png", options.dumpFramesDir.c_str(), (unsigned long long)frame.tick);
+            if (renderer->framebuffer().savePng(path)) dumped++;
+            else std::cerr << "Warning: could not write " << path << std::endl;
+        }
+    }
+
+    if (!options.recordInputPath.empty()) {
+        sim.finishRecording();
+        if (!recording.save(options.recordInputPath)) {
+            std::cerr << "Warning: could not write input recording " << options.recordInputPath << std::endl;
+        }
+    }
+
+    std::cout << "Headless run: seed " << seed << ", " << ticks << " ticks"
+        << (replaying ? ", " : "") << (replaying ? std::to_string(replay.events.size()) + " input events" : "")
+        << " in " << seconds * 1000 << " ms (" << (seconds > 0 ? ticks / seconds : 0) << " ticks/s)" << std::endl;
+    std::cout << "Score " << sim.currentScore() << (sim.gameOver() ? ", game over" : "")
+        << ", state checksum " << std::hex << sim.checksum() << std::dec << std::endl;
+    if (renderedFrames > 0) {
+        std::cout << "Software renderer: " << renderedFrames << " frames, avg " << renderMs / renderedFrames
+            << " ms, worst " << worstRenderMs << " ms, " << drawCalls / renderedFrames << " draws and "
+            << vertices / renderedFrames << " vertices per frame" << std::endl;
+        if (dumped > 0) std::cout << "Saved " << dumped << " frames to " << options.dumpFramesDir << std::endl;
+    }
+
+    MemoryReport memory;
+    memory.add("Track", std::to_string(sim.trackCapacity()) + " segments x " + std::to_string(sizeof(Line)) + " bytes",
+        sim.trackCapacity() * sizeof(Line));
+    memory.add("System memory", "frame snapshot", frame.capacityBytes());
+    memory.add("System memory", "frame arena", arena.capacityBytes());
+    if (renderer) {
+        memory.add("System memory", "software renderer images", renderer->imageBytes());
+        memory.add("System memory", "software framebuffer", std::uint64_t(WIDTH) * HEIGHT * 4);
+    }
+    memory.print(std::cout);
+
+    if (!allocationCountingEnabled()) {
+        if (options.checkAllocations) {
+            std::cout << "Steady-state heap allocations: not counted in this build" << std::endl;
+            return 77;
+        }
+        return 0;
+    }
+    std::cout << "Steady-state heap allocations: " << steadyStateAllocations << std::endl;
+    return options.checkAllocations && steadyStateAllocations > 0 ? 1 : 0;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include "GameConfig.h"
+#include "FrameSnapshot.h"
+
+// Heads-up display: score, speed and remaining boosts.
+// Labels and the booster layout are built once. Numbers are drawn from a prebaked
+// digit strip in one vertex array, so a changed value only rewrites a few quads and
+// an unchanged one costs nothing but the draw calls.
+class Hud {
+public:
+    void create(const sf::Font& font) {
+        bakeDigits(font);
+
+        setupLabel(scoreLabel, font, "Score: ", sf::Color::Yellow);
+        scoreLabel.setPosition(10, 10);
+
+        setupLabel(speedLabel, font, "Speed: ", sf::Color::Cyan);
+        speedLabel.setPosition(10, 40);
+        setupLabel(speedUnit, font, " km/h", sf::Color::Cyan);
+        setupLabel(boostingLabel, font, " [BOOSTING!]", sf::Color::Cyan);
+
+        digits.setPrimitiveType(sf::Triangles);
+        boosterIcons.setPrimitiveType(sf::Triangles);
+    }
+
+    // Optional booster counter on the right side; its layout never changes so it is computed here
+    void setBoosterUI(const sf::Texture& iconTex, const sf::Texture& textTex) {
+        const float marginRight = 10.f;
+        const float marginTop = 4.f;
+        const float vGap = 0.f;
+
+        boosterIconTex = &iconTex;
+        boosterText.setTexture(textTex, true);
+
+        // Use only texture's actual pixel width (ignoring padding)
+        float iconWidth = float(iconTex.getSize().x);
+        float iconHeight = float(iconTex.getSize().y);
+
+        // Booster text bounds
+        sf::FloatRect textBounds = boosterText.getLocalBounds();
+        boosterText.setOrigin(textBounds.left, textBounds.top);
+
+        float totalIconRowWidth = MAX_BOOSTERS * iconWidth;
+
+        // Position text so icons fit under it, aligned to right
+        float textX = WIDTH - marginRight - totalIconRowWidth / 2.f - textBounds.width / 2.f;
+        float textY = marginTop;
+        boosterText.setPosition(textX, textY);
+
+        // Base position for first icon (centered under text)
+        float baseX = textX + textBounds.width / 2.f - totalIconRowWidth / 2.f;
+        float baseY = textY + textBounds.height + vGap;
+
+        // Boosters touching (no transparent gap)
+        boosterIcons.clear();
+        for (int i = 0; i < MAX_BOOSTERS; i++) {
+            appendQuad(boosterIcons, sf::FloatRect(baseX + i * iconWidth, baseY, iconWidth, iconHeight),
+                sf::FloatRect(0, 0, iconWidth, iconHeight), sf::Color::White);
+        }
+        hasBoosterUI = true;
+        shownBoosts = -1;
+    }
+
+    // Rebuild only the parts whose values changed since the last frame
+    void update(const FrameSnapshot& frame) {
+        if (frame.score != shownScore || frame.speed != shownSpeed) {
+            shownScore = frame.score;
+            shownSpeed = frame.speed;
+            rebuilds++;
+
+            digits.clear();
+            appendNumber(frame.score, scoreLabel, sf::Color::Yellow);
+            float speedEnd = appendNumber(frame.speed, speedLabel, sf::Color::Cyan);
+            speedUnit.setPosition(speedEnd, speedLabel.getPosition().y);
+            boostingLabel.setPosition(speedUnit.findCharacterPos(speedUnit.getString().getSize()).x, speedLabel.getPosition().y);
+        }
+
+        if (hasBoosterUI && frame.boostsLeft != shownBoosts) {
+            shownBoosts = frame.boostsLeft;
+            for (int i = 0; i < MAX_BOOSTERS; i++) {
+                sf::Color c = (i < frame.boostsLeft) ? sf::Color::White : sf::Color(255, 255, 255, 80);
+                for (int v = 0; v < 6; v++) boosterIcons[i * 6 + v].color = c;
+            }
+        }
+
+        showBoosting = frame.isBoosting;
+    }
+
+    // Returns the number of draw calls
+    int draw(sf::RenderTarget& target) const {
+        target.draw(scoreLabel);
+        target.draw(speedLabel);
+        target.draw(digits, &digitStrip.getTexture());
+        target.draw(speedUnit);
+        int calls = 4;
+        if (showBoosting) {
+            target.draw(boostingLabel);
+            calls++;
+        }
+
+        if (hasBoosterUI) {
+            target.draw(boosterText);
+            target.draw(boosterIcons, boosterIconTex);
+            calls += 2;
+        }
+        return calls;
+    }
+
+    // How many times the number geometry has been rebuilt
+    unsigned long rebuildCount() const { return rebuilds; }
+
+private:
+    static const unsigned CHAR_SIZE = 25;
+    static const int MAX_BOOSTERS = 3;
+    const float OUTLINE = 2.f;
+
+    static void setupLabel(sf::Text& t, const sf::Font& font, const char* s, sf::Color fill) {
+        t.setFont(font);
+        t.setCharacterSize(CHAR_SIZE);
+        t.setString(s);
+        t.setFillColor(fill);
+        t.setOutlineColor(sf::Color::Black);
+        t.setOutlineThickness(2);
+    }
+
+    static void appendQuad(sf::VertexArray& va, sf::FloatRect dst, sf::FloatRect src, sf::Color c) {
+        sf::Vertex tl(sf::Vector2f(dst.left, dst.top), c, sf::Vector2f(src.left, src.top));
+        sf::Vertex tr(sf::Vector2f(dst.left + dst.width, dst.top), c, sf::Vector2f(src.left + src.width, src.top));
+        sf::Vertex br(sf::Vector2f(dst.left + dst.width, dst.top + dst.height), c, sf::Vector2f(src.left + src.width, src.top + src.height));
+        sf::Vertex bl(sf::Vector2f(dst.left, dst.top + dst.height), c, sf::Vector2f(src.left, src.top + src.height));
+        va.append(tl);
+        va.append(tr);
+        va.append(br);
+        va.append(tl);
+        va.append(br);
+        va.append(bl);
+    }
+
+    // Render 0-9 once, white with a black outline, into a strip of equal cells.
+    // Vertex colors tint the white fill while the outline stays black.
+    void bakeDigits(const sf::Font& font) {
+        pad = OUTLINE + 2.f;
+        float maxAdvance = 0;
+        for (int d = 0; d < 10; d++) {
+            advance[d] = font.getGlyph('0' + d, CHAR_SIZE, false).advance;
+            maxAdvance = std::max(maxAdvance, advance[d]);
+        }
+        cellW = std::ceil(maxAdvance + 2 * pad);
+        cellH = std::ceil(font.getLineSpacing(CHAR_SIZE) + 2 * pad);
+
+        digitStrip.create(unsigned(cellW) * 10, unsigned(cellH));
+        digitStrip.clear(sf::Color::Transparent);
+        sf::Text t;
+        setupLabel(t, font, "", sf::Color::White);
+        t.setOutlineThickness(OUTLINE);
+        for (int d = 0; d < 10; d++) {
+            t.setString(sf::String(sf::Uint32('0' + d)));
+            t.setPosition(d * cellW + pad, pad);
+            digitStrip.draw(t);
+        }
+        digitStrip.display();
+    }
+
+    // Append `value` right after `label`; returns the x where the number ends
+    float appendNumber(int value, const sf::Text& label, sf::Color color) {
+        char buf[12];
+        int len = 0;
+        unsigned v = value < 0 ? 0u : unsigned(value);
+        do {
+            buf[len++] = char('0' + v % 10);
+            v /= 10;
+        } while (v > 0 && len < 12);
+
+        float penX = label.findCharacterPos(label.getString().getSize()).x;
+        float y = label.getPosition().y;
+        for (int i = len - 1; i >= 0; i--) {
+            int d = buf[i] - '0';
+            appendQuad(digits, sf::FloatRect(penX - pad, y - pad, cellW, cellH),
+                sf::FloatRect(d * cellW, 0, cellW, cellH), color);
+            penX += advance[d];
+        }
+        return penX;
+    }
+
+    sf::RenderTexture digitStrip;
+    float advance[10] = {};
+    float cellW = 0, cellH = 0, pad = 0;
+
+    sf::Text scoreLabel, speedLabel, speedUnit, boostingLabel;
+    sf::VertexArray digits;
+
+    const sf::Texture* boosterIconTex = nullptr;
+    sf::Sprite boosterText;
+    sf::VertexArray boosterIcons;
+    bool hasBoosterUI = false;
+
+    int shownScore = -1, shownSpeed = -1, shownBoosts = -1;
+    bool showBoosting = false;
+    unsigned long rebuilds = 0;
+};
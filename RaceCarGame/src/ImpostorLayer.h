@@ -0,0 +1,98 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+#include "FrameSnapshot.h"
+
+// Far-field scenery rendered offscreen at a reduced rate and composited as one quad.
+// Beyond the split distance scenery is only a few pixels across, so redrawing it every
+// few ticks (or when the camera swings sideways or moves a couple of segments) is
+// indistinguishable from every frame. It is also redrawn as soon as an object crosses
+// the split, so nothing is drawn twice or missing while it moves to the near list.
+class ImpostorLayer {
+public:
+    bool create(int refreshEveryTicks) {
+        refreshTicks = std::uint64_t(refreshEveryTicks);
+        if (!target.create(WIDTH, HEIGHT)) return false;
+        composite.setTexture(target.getTexture());
+        return true;
+    }
+
+    // Re-render the band if it is stale; returns true when it did
+    bool update(const FrameSnapshot& frame, const sf::Texture* sceneryTextures) {
+        bool stale = !initialized
+            || frame.restartCue != refreshRestartCue  // a new race, possibly on a regenerated track
+            || frame.tick - refreshTick >= refreshTicks
+            || frame.farSceneryKey != refreshKey
+            || std::abs(frame.playerX - refreshPlayerX) > 0.02f
+            || std::abs(frame.pos - refreshPos) >= SEG_LEN * 2;
+        if (!stale) return false;
+
+        initialized = true;
+        refreshTick = frame.tick;
+        refreshPlayerX = frame.playerX;
+        refreshPos = frame.pos;
+        refreshKey = frame.farSceneryKey;
+        refreshRestartCue = frame.restartCue;
+        refreshes++;
+
+        // Only the band the far billboards cover gets composited
+        float top = float(HEIGHT), bottom = 0, left = float(WIDTH), right = 0;
+        for (const Billboard& b : frame.farBillboards) {
+            top = std::min(top, b.rect.top);
+            bottom = std::max(bottom, b.rect.top + b.rect.height);
+            left = std::min(left, b.rect.left);
+            right = std::max(right, b.rect.left + b.rect.width);
+        }
+        int x0 = std::max(0, int(std::floor(left))), y0 = std::max(0, int(std::floor(top)));
+        int x1 = std::min(WIDTH, int(std::ceil(right))), y1 = std::min(HEIGHT, int(std::ceil(bottom)));
+        hasBand = x1 > x0 && y1 > y0;
+        if (!hasBand) return true;
+
+        // Draw with premultiplied alpha so transparent texels don't darken sprite edges
+        const sf::BlendMode premultiply(sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+            sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+        target.clear(sf::Color::Transparent);
+        for (const Billboard& b : frame.farBillboards) {
+            const sf::Texture& tex = sceneryTextures[b.texture];
+            sprite.setTexture(tex, true);
+            sprite.setScale(b.rect.width / tex.getSize().x, b.rect.height / tex.getSize().y);
+            sprite.setPosition(b.rect.left, b.rect.top);
+            target.draw(sprite, premultiply);
+        }
+        target.display();
+
+        composite.setTextureRect(sf::IntRect(x0, y0, x1 - x0, y1 - y0));
+        composite.setPosition(float(x0), float(y0));
+        return true;
+    }
+
+    // Returns false when there was nothing to draw
+    bool draw(sf::RenderTarget& window) const {
+        if (!hasBand) return false;
+        window.draw(composite, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+        return true;
+    }
+
+    unsigned long refreshCount() const { return refreshes; }
+    std::uint64_t textureBytes() const { return std::uint64_t(target.getSize().x) * target.getSize().y * 4; }
+
+private:
+    sf::RenderTexture target;
+    sf::Sprite sprite;
+    sf::Sprite composite;
+    bool initialized = false;
+    bool hasBand = false;             // any far scenery in the last refresh
+
+    std::uint64_t refreshTicks = 3;
+    std::uint64_t refreshTick = 0;
+    unsigned refreshRestartCue = 0;
+    float refreshPlayerX = 0;
+    int refreshPos = 0;
+    std::uint64_t refreshKey = 0;     // farSceneryKey of the frame last drawn
+    unsigned long refreshes = 0;
+};
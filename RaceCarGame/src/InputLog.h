@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "InputQueue.h"
+
+// Everything needed to replay a run: the track seed, how long it ran and every
+// input event tagged with the tick it was applied on. Saved as plain text:
+//   seed 1234
+//   ticks 5400
+//   120 71 1      (tick, sf::Keyboard::Key, pressed)
+struct InputLog {
+    unsigned seed = 0;
+    std::uint64_t ticks = 0;
+    std::vector<InputEvent> events;
+
+    bool save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) return false;
+        file << "seed " << seed << "\n" << "ticks " << ticks << "\n";
+        for (const InputEvent& e : events) {
+            file << e.tick << " " << int(e.key) << " " << (e.pressed ? 1 : 0) << "\n";
+        }
+        return bool(file);
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream file(path);
+        std::string word;
+        if (!(file >> word >> seed) || word != "seed") return false;
+        if (!(file >> word >> ticks) || word != "ticks") return false;
+
+        events.clear();
+        InputEvent e;
+        int key, pressed;
+        while (file >> e.tick >> key >> pressed) {
+            if (key < 0 || key >= sf::Keyboard::KeyCount || e.tick == 0) return false;
+            if (!events.empty() && e.tick < events.back().tick) return false;
+            e.key = sf::Keyboard::Key(key);
+            e.pressed = pressed != 0;
+            events.push_back(e);
+        }
+        return file.eof();
+    }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SpscQueue.h"
+
+// A key press or release. Live input is stamped with the time it was polled;
+// recorded and scripted input with the tick it is applied on.
+struct InputEvent {
+    sf::Keyboard::Key key = sf::Keyboard::Unknown;
+    bool pressed = false;
+    std::int64_t timeUs = 0;  // steadyMicros() when the event was polled
+    std::uint64_t tick = 0;   // 0 = live event, placed by timeUs
+};
+
+// Hands the simulation each tick's input, in order. Live events from the window go
+// on the first tick that starts after they were polled, so every press lands on one
+// tick however fast or slow the renderer runs. A script (replay or headless run)
+// feeds events that already carry their tick through the same path.
+class InputQueue {
+public:
+    // Render thread; returns false if the simulation has fallen 256 events behind
+    bool push(const InputEvent& e) { return live.push(e); }
+
+    // Set before the simulation starts; the script must be sorted by tick and outlive the queue
+    void play(const std::vector<InputEvent>* events) {
+        script = events;
+        scriptNext = 0;
+    }
+
+    bool isScripted() const { return script != nullptr; }
+
+    // Simulation thread: next event due on `tick`, which is scheduled to start at `tickStartUs`
+    bool popDue(std::uint64_t tick, std::int64_t tickStartUs, InputEvent& out) {
+        if (script) {
+            if (scriptNext >= script->size() || (*script)[scriptNext].tick > tick) return false;
+            out = (*script)[scriptNext++];
+            return true;
+        }
+
+        if (!hasPending && !live.pop(pending)) return false;
+        // Polled after this tick was due: hold it for the next one
+        if (pending.timeUs > tickStartUs) {
+            hasPending = true;
+            return false;
+        }
+        hasPending = false;
+        out = pending;
+        return true;
+    }
+
+private:
+    SpscQueue<InputEvent, 256> live;
+    InputEvent pending;
+    bool hasPending = false;
+
+    const std::vector<InputEvent>* script = nullptr;
+    std::size_t scriptNext = 0;
+};
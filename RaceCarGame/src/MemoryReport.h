@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+
+// What the game holds on purpose, owner by owner, for sizing target hardware: the
+// track, textures (GPU memory, assumed RGBA8), decoded sound, frame buffers. Printed
+// next to what the heap counter and the OS saw, which also includes everything
+// nobody accounted for.
+class MemoryReport {
+public:
+    void add(const char* group, const std::string& name, std::uint64_t bytes) {
+        entries.push_back({ group, name, bytes });
+    }
+
+    void addTexture(const std::string& name, const sf::Texture& texture) {
+        add("Textures", name, std::uint64_t(texture.getSize().x) * texture.getSize().y * 4);
+    }
+
+    void addSoundBuffer(const std::string& name, const sf::SoundBuffer& buffer) {
+        add("Sound buffers", name, buffer.getSampleCount() * sizeof(sf::Int16));
+    }
+
+    std::uint64_t totalBytes() const {
+        std::uint64_t total = 0;
+        for (const Entry& e : entries) total += e.bytes;
+        return total;
+    }
+
+    // One line per entry under its group's subtotal, groups in the order first added
+    void print(std::ostream& out) const {
+        out << "Memory:" << std::endl;
+        std::vector<std::string> groups;
+        for (const Entry& e : entries) {
+            if (std::find(groups.begin(), groups.end(), e.group) == groups.end()) groups.push_back(e.group);
+        }
+        for (const std::string& group : groups) {
+            std::uint64_t subtotal = 0;
+            for (const Entry& e : entries) subtotal += e.group == group ? e.bytes : 0;
+            out << "  " << group << ": " << kb(subtotal) << std::endl;
+            for (const Entry& e : entries) {
+                if (e.group == group) out << "    " << e.name << ": " << kb(e.bytes) << std::endl;
+            }
+        }
+        out << "  Accounted for: " << kb(totalBytes()) << std::endl;
+        printHeap(out);
+    }
+
+    // Heap and process high-water marks; on their own at exit
+    static void printHeap(std::ostream& out) {
+        if (allocationCountingEnabled()) {
+            out << "  Heap: " << kb(heapBytesInUse()) << " in use, peak " << kb(peakHeapBytes()) << std::endl;
+        }
+        else {
+            out << "  Heap: only counted in debug builds" << std::endl;
+        }
+        out << "  Peak resident: " << kb(peakResidentBytes()) << std::endl;
+    }
+
+    static std::string kb(std::uint64_t bytes) {
+        return std::to_string((bytes + 512) / 1024) + " KB";
+    }
+
+private:
+    struct Entry {
+        std::string group;
+        std::string name;
+        std::uint64_t bytes;
+    };
+
+    std::vector<Entry> entries;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+
+// Philox4x32-10, a counter-based random number generator (Salmon et al., "Parallel
+// random numbers: as easy as 1, 2, 3"). The output for a counter depends only on that
+// counter and the key, so numbers can be drawn in any order and on any thread.
+struct Philox4x32 {
+    std::uint32_t v[4];
+
+    Philox4x32(const std::uint32_t counter[4], const std::uint32_t key[2]) {
+        std::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            if (round > 0) {
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            std::uint64_t p0 = std::uint64_t(0xD2511F53u) * c0;
+            std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * c2;
+            std::uint32_t hi0 = std::uint32_t(p0 >> 32), lo0 = std::uint32_t(p0);
+            std::uint32_t hi1 = std::uint32_t(p1 >> 32), lo1 = std::uint32_t(p1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+        }
+        v[0] = c0;
+        v[1] = c1;
+        v[2] = c2;
+        v[3] = c3;
+    }
+};
+
+// A short stream of numbers for one (key, counter) pair: draws walk the fourth
+// counter word, four numbers per block
+class CounterRandom {
+public:
+    CounterRandom(std::uint32_t key0, std::uint32_t key1, std::uint32_t c0, std::uint32_t c1, std::uint32_t c2)
+        : key{ key0, key1 }, counter{ c0, c1, c2, 0 } {}
+
+    std::uint32_t next() {
+        if (used == 4) {
+            Philox4x32 block(counter, key);
+            for (int i = 0; i < 4; i++) buffer[i] = block.v[i];
+            counter[3]++;
+            used = 0;
+        }
+        return buffer[used++];
+    }
+
+    // 0..n-1
+    int uniform(int n) { return int((std::uint64_t(next()) * std::uint32_t(n)) >> 32); }
+
+    // [lo, hi)
+    float uniform(float lo, float hi) { return lo + (hi - lo) * float(next() >> 8) * (1.f / 16777216); }
+
+private:
+    std::uint32_t key[2];
+    std::uint32_t counter[4];
+    std::uint32_t buffer[4] = {};
+    int used = 4;
+};
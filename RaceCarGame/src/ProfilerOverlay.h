@@ -0,0 +1,112 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include "TextUtil.h"
+
+// Numbers the overlay shows; filled in by the render loop every frame
+struct ProfilerReadout {
+    float frameMs = 0;             // render work, wake-up to present
+    int qualityLevel = 0;
+    std::uint64_t droppedFrames = 0;
+    std::uint64_t repeatedFrames = 0;
+    std::uint64_t missedDeadlines = 0;
+    int roadSegments = 0;
+    int projectedSegments = 0;
+    int billboards = 0;
+    bool lateInput = false;
+};
+
+// Rolling input-to-present latency: time from a key being seen to the first
+// presented frame that shows its effect
+class LatencyMeter {
+public:
+    void add(float ms) {
+        last = ms;
+        worst = std::max(worst, ms);
+        total += ms;
+        count++;
+    }
+
+    float lastMs() const { return last; }
+    float averageMs() const { return count ? float(total / count) : 0.f; }
+    float worstMs() const { return worst; }
+    std::uint64_t samples() const { return count; }
+
+private:
+    float last = 0, worst = 0;
+    double total = 0;
+    std::uint64_t count = 0;
+};
+
+// F3 toggles a small text panel with frame timing, pacing and latency numbers.
+// The text is rebuilt a few times per second, not every frame.
+class ProfilerOverlay {
+public:
+    void create(const sf::Font& font) {
+        text.setFont(font);
+        text.setCharacterSize(16);
+        text.setFillColor(sf::Color::White);
+        text.setOutlineColor(sf::Color::Black);
+        text.setOutlineThickness(1);
+        text.setPosition(10, 80);
+        panel.setFillColor(sf::Color(0, 0, 0, 150));
+        panel.setPosition(5, 75);
+    }
+
+    // Showing starts a fresh average, so time spent hidden (menus, other screens) doesn't
+    // leak into the first numbers, and fills the panel on the next update
+    void toggle() {
+        visible = !visible;
+        frameMsTotal = 0;
+        frames = 0;
+        refreshNow = visible;
+    }
+    bool isVisible() const { return visible; }
+
+    void update(const ProfilerReadout& r, const LatencyMeter& latency) {
+        if (!visible) return;
+        frameMsTotal += r.frameMs;
+        frames++;
+        if (frames < REFRESH_FRAMES && !refreshNow) return;
+        refreshNow = false;
+
+        snprintf(buffer, sizeof(buffer),
+            "frame %.2f ms  quality %d\n"
+            "sim dropped %llu  repeated %llu  missed %llu\n"
+            "road %d/%d segs  billboards %d\n"
+            "input->present %.1f ms (avg %.1f, max %.1f)%s",
+            frameMsTotal / frames, r.qualityLevel,
+            (unsigned long long)r.droppedFrames, (unsigned long long)r.repeatedFrames,
+            (unsigned long long)r.missedDeadlines,
+            r.roadSegments, r.projectedSegments, r.billboards,
+            latency.lastMs(), latency.averageMs(), latency.worstMs(),
+            r.lateInput ? "  late input" : "");
+        setTextString(text, scratch, buffer);
+
+        sf::FloatRect bounds = text.getLocalBounds();
+        panel.setSize(sf::Vector2f(bounds.width + 15, bounds.height + 15));
+        frameMsTotal = 0;
+        frames = 0;
+    }
+
+    void draw(sf::RenderTarget& target) const {
+        if (!visible) return;
+        target.draw(panel);
+        target.draw(text);
+    }
+
+private:
+    static const int REFRESH_FRAMES = 20;
+
+    sf::Text text;
+    sf::RectangleShape panel;
+    sf::String scratch;
+    char buffer[256];
+    bool visible = false;
+    bool refreshNow = false;          // just shown: don't wait a full refresh period
+    float frameMsTotal = 0;
+    int frames = 0;
+};
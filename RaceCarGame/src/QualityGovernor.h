@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+
+// One step of the quality ladder. Lower levels give up horizon scenery first, then view distance.
+struct QualityLevel {
+    int viewSegments;     // segments projected per frame
+    int roadSegments;     // segments that get road quads
+    int scenerySegments;  // scenery further than this is not drawn
+    int sceneryDensity;   // percent of scenery objects kept
+};
+
+const QualityLevel QUALITY_LEVELS[] = {
+    { 300, 200, 40, 50 },
+    { 400, 300, 60, 70 },
+    { 600, 400, 80, 100 },
+    { 800, 600, 100, 100 },
+    { VIEW_SEGMENTS, VIEW_SEGMENTS, 120, 100 },  // full quality
+};
+const int QUALITY_LEVEL_COUNT = int(sizeof(QUALITY_LEVELS) / sizeof(QUALITY_LEVELS[0]));
+
+// The --stress scene, above the ladder: full view distance, and scenery as far out as
+// opponents are drawn
+const QualityLevel STRESS_QUALITY = { VIEW_SEGMENTS, VIEW_SEGMENTS, OPPONENT_DRAW_SEGMENTS, 100 };
+
+struct QualityAdjustment {
+    std::uint64_t frame;
+    int fromLevel;
+    int toLevel;
+    float averageMs;      // average frame time that triggered the change
+};
+
+// Watches recent frame times and moves the quality level to hold a frame-time budget.
+// Steps down quickly when over budget, steps up only after a long stretch well under it,
+// and waits after every change so one level can settle before the next is judged.
+class QualityGovernor {
+public:
+    QualityGovernor(float budgetMs, int startLevel)
+        : budget(budgetMs), current(clampLevel(startLevel)) {
+        adjustments.reserve(256);
+    }
+
+    // Feed one frame's work time; returns true when the level changed
+    bool addFrame(float ms) {
+        frames++;
+        if (budget <= 0) return false;
+
+        samples[sampleCount % WINDOW] = ms;
+        sampleCount++;
+        if (cooldown > 0) {
+            cooldown--;
+            return false;
+        }
+        if (sampleCount < WINDOW) return false;
+
+        float sum = 0;
+        for (float s : samples) sum += s;
+        float average = sum / WINDOW;
+
+        if (average > budget * DOWN_THRESHOLD && current > 0) {
+            return change(current - 1, average);
+        }
+
+        underBudgetFrames = (average < budget * UP_THRESHOLD) ? underBudgetFrames + 1 : 0;
+        if (underBudgetFrames >= UP_FRAMES && current < QUALITY_LEVEL_COUNT - 1) {
+            return change(current + 1, average);
+        }
+        return false;
+    }
+
+    int level() const { return current; }
+    float budgetMs() const { return budget; }
+    const std::vector<QualityAdjustment>& log() const { return adjustments; }
+
+private:
+    static const int WINDOW = 30;          // frames averaged
+    static const int COOLDOWN = 60;        // frames ignored after a change
+    static const int UP_FRAMES = 120;      // frames well under budget before stepping up
+    static constexpr float DOWN_THRESHOLD = 0.9f;
+    static constexpr float UP_THRESHOLD = 0.6f;
+
+    static int clampLevel(int l) {
+        return l < 0 ? 0 : (l >= QUALITY_LEVEL_COUNT ? QUALITY_LEVEL_COUNT - 1 : l);
+    }
+
+    bool change(int to, float average) {
+        QualityAdjustment a = { frames, current, to, average };
+        // No console output here, mid-game: the F3 overlay shows the current level
+        // and the exit report lists every adjustment
+        if (adjustments.size() < adjustments.capacity()) adjustments.push_back(a);
+
+        current = to;
+        cooldown = COOLDOWN;
+        underBudgetFrames = 0;
+        sampleCount = 0;
+        return true;
+    }
+
+    float budget;
+    int current;
+    float samples[WINDOW] = {};
+    int sampleCount = 0;
+    int cooldown = 0;
+    int underBudgetFrames = 0;
+    std::uint64_t frames = 0;
+    std::vector<QualityAdjustment> adjustments;
+};
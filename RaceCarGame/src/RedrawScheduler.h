@@ -0,0 +1,120 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include "Timing.h"
+
+// Animated titles on waiting screens are redrawn this often, not at the display rate
+const float MENU_ANIMATION_FPS = 20.f;
+
+// Longest an animated screen sleeps before checking for input again
+const std::int64_t SCREEN_POLL_INTERVAL_US = 10000;
+
+// Time spent on one screen and what it cost, for the report at exit
+struct ScreenUsage {
+    const char* name = "";
+    std::int64_t wallUs = 0;
+    std::int64_t cpuUs = 0;   // whole process, so audio and simulation threads count too
+    std::uint64_t redraws = 0;
+
+    explicit ScreenUsage(const char* screenName) : name(screenName) {}
+
+    void enter() {
+        enteredWallUs = steadyMicros();
+        enteredCpuUs = processCpuMicros();
+    }
+
+    void leave() {
+        wallUs += steadyMicros() - enteredWallUs;
+        cpuUs += processCpuMicros() - enteredCpuUs;
+    }
+
+    void print(std::ostream& out) const {
+        if (wallUs <= 0) return;
+        double seconds = wallUs / 1e6;
+        out << name << ": " << seconds << " s shown, " << cpuUs / 1e6 << " s CPU ("
+            << 100.0 * cpuUs / wallUs << "%), " << redraws << " redraws (" << redraws / seconds << "/s)" << std::endl;
+    }
+
+private:
+    std::int64_t enteredWallUs = 0;
+    std::int64_t enteredCpuUs = 0;
+};
+
+// Whether an event can change what a waiting screen shows. Mouse motion and key
+// releases don't, and regaining focus or being resized may have left the window
+// contents stale. (SFML has no expose event, so an uncovered window that keeps its
+// focus is only repainted by the next redraw.)
+inline bool eventNeedsRedraw(const sf::Event& e) {
+    return e.type == sf::Event::KeyPressed || e.type == sf::Event::Resized
+        || e.type == sf::Event::GainedFocus || e.type == sf::Event::MouseEntered;
+}
+
+// Render-on-demand for screens that wait for the player. A static screen
+// (animationFps 0) blocks in waitEvent and is redrawn only after an event that can
+// change it or invalidate(); an animated one is also redrawn every 1/animationFps
+// seconds and sleeps in between. Time spent between construction and destruction
+// goes to `usage`.
+//
+//     RedrawScheduler redraw(usage, MENU_ANIMATION_FPS);
+//     while (window.isOpen()) {
+//         while (redraw.nextEvent(window, e)) { handle e }
+//         draw and display
+//     }
+class RedrawScheduler {
+public:
+    explicit RedrawScheduler(ScreenUsage& screenUsage, float animationFps = 0)
+        : usage(screenUsage), frameUs(animationFps > 0 ? std::int64_t(1e6f / animationFps) : 0) {
+        usage.enter();
+    }
+
+    ~RedrawScheduler() { usage.leave(); }
+
+    RedrawScheduler(const RedrawScheduler&) = delete;
+    RedrawScheduler& operator=(const RedrawScheduler&) = delete;
+
+    // The next event to handle, waiting for as long as nothing needs drawing. False
+    // when the screen should be redrawn now, or the window has been closed.
+    bool nextEvent(sf::RenderWindow& window, sf::Event& e) {
+        if (!window.isOpen()) return false;
+        if (window.pollEvent(e)) return noteEvent(e);
+
+        while (!dirty) {
+            if (frameUs == 0) {
+                if (!window.waitEvent(e)) return false;
+                return noteEvent(e);
+            }
+
+            std::int64_t now = steadyMicros();
+            if (now >= nextFrameUs) break;
+            sf::sleep(sf::microseconds(std::min(nextFrameUs - now, SCREEN_POLL_INTERVAL_US)));
+            if (window.pollEvent(e)) return noteEvent(e);
+        }
+
+        dirty = false;
+        usage.redraws++;
+        if (frameUs > 0) {
+            // Keep a steady cadence, but don't catch up on frames missed while busy
+            std::int64_t now = steadyMicros();
+            nextFrameUs += frameUs;
+            if (nextFrameUs <= now) nextFrameUs = now + frameUs;
+        }
+        return false;
+    }
+
+    // Something the screen shows changed outside of an event
+    void invalidate() { dirty = true; }
+
+private:
+    bool noteEvent(const sf::Event& e) {
+        if (eventNeedsRedraw(e)) dirty = true;
+        return true;
+    }
+
+    ScreenUsage& usage;
+    std::int64_t frameUs;
+    std::int64_t nextFrameUs = 0;
+    bool dirty = true;  // the first frame
+};
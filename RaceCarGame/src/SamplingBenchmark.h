@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "GameConfig.h"
+#include "BillboardTextures.h"
+#include "GameOptions.h"
+
+// --bench-sampling: draw the same field of minified scenery billboards offscreen with
+// and without mipmaps and compare frame times. The readback at the end of each run
+// waits for the GPU, so the time covers the sampling and not just command submission.
+inline int runSamplingBenchmark(const GameOptions& options) {
+    const char* paths[4] = { "images/4.png", "images/5.png", "images/7.png", "images/6.png" };
+    const int SPRITES = 3000;
+    const int FRAMES = 120;
+
+    sf::RenderTexture target;
+    if (!target.create(WIDTH, HEIGHT)) {
+        std::cerr << "Error: could not create an offscreen target" << std::endl;
+        return 1;
+    }
+
+    struct Config {
+        const char* name;
+        MipmapSettings mipmaps;
+    };
+    MipmapSettings noMips, mips, dropped;
+    noMips.enabled = false;
+    dropped.dropLevels = options.mipDropLevels > 0 ? options.mipDropLevels : 1;
+    const Config configs[] = { { "full size, no mipmaps", noMips }, { "mipmapped", mips }, { "mipmapped, top levels dropped", dropped } };
+
+    for (const Config& config : configs) {
+        sf::Texture textures[4];
+        sf::Vector2u sourceSizes[4];
+        TextureMemory memory;
+        for (int i = 0; i < 4; i++) {
+            if (!loadBillboardTexture(textures[i], sourceSizes[i], paths[i], config.mipmaps, memory)) {
+                std::cerr << "Error: could not load " << paths[i] << std::endl;
+                return 1;
+            }
+        }
+
+        // Same layout for every configuration: the far-horizon to medium scale bands
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> scale(0.02f, 0.35f), x(0, WIDTH), y(0, HEIGHT * 0.6f);
+        std::vector<sf::Sprite> sprites(SPRITES);
+        for (int i = 0; i < SPRITES; i++) {
+            int t = i % 4;
+            float s = scale(rng);
+            sprites[i].setTexture(textures[t], true);
+            // Sized from the source image, like the game's layout
+            sprites[i].setScale(s * sourceSizes[t].x / textures[t].getSize().x, s * sourceSizes[t].y / textures[t].getSize().y);
+            sprites[i].setPosition(x(rng), y(rng));
+        }
+
+        // One untimed frame so texture uploads and driver setup don't count
+        target.clear(sf::Color::Transparent);
+        for (const sf::Sprite& sprite : sprites) target.draw(sprite);
+        target.display();
+        target.getTexture().copyToImage();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < FRAMES; f++) {
+            target.clear(sf::Color::Transparent);
+            for (const sf::Sprite& sprite : sprites) target.draw(sprite);
+            target.display();
+        }
+        target.getTexture().copyToImage();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << config.name << ": " << ms / FRAMES << " ms per frame (" << SPRITES << " billboards), "
+            << memory.bytes / 1024 << " KB textures (" << memory.fullSizeBytes / 1024 << " KB at source size)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "FrameRenderer.h"
+#include "Hud.h"
+#include "ImpostorLayer.h"
+#include "TiledPanorama.h"
+
+// The game's normal renderer: draws frames into an SFML window through OpenGL
+class SfmlBackend : public RenderBackend {
+public:
+    SfmlBackend(sf::RenderTarget& target, TiledPanorama& background, ImpostorLayer& farScenery,
+        const sf::Texture* opponentTextures, const sf::Texture* sceneryTextures,
+        const sf::Texture& playerTexture, Hud& hud)
+        : target(target), background(background), farScenery(farScenery),
+          opponentTextures(opponentTextures), sceneryTextures(sceneryTextures), hud(hud) {
+        player.setSize(PLAYER_SIZE);
+        player.setTexture(&playerTexture);
+        player.setOrigin(PLAYER_SIZE.x / 2, PLAYER_SIZE.y / 2);
+    }
+
+    void clear(sf::Color color) override {
+        target.clear(color);
+    }
+
+    void drawBackground(float playerX) override {
+        if (!background.isLoaded()) return;
+        count(background.draw(target, panoramaPan(background.width(), playerX)), 4);
+    }
+
+    void drawTriangles(const sf::Vertex* vertices, std::size_t n) override {
+        target.draw(vertices, n, sf::Triangles);
+        stats.drawCalls++;
+        stats.vertices += n;
+    }
+
+    // Far scenery comes from the impostor, redrawn every few ticks
+    void drawFarScenery(const FrameSnapshot& frame) override {
+        farScenery.update(frame, sceneryTextures);
+        count(farScenery.draw(target) ? 1 : 0, 4);
+    }
+
+    void drawBillboard(const Billboard& b) override {
+        const sf::Texture& tex = (b.kind == OPPONENT_BILLBOARD) ? opponentTextures[b.texture] : sceneryTextures[b.texture];
+        billboard.setTexture(tex, true);
+        billboard.setScale(b.rect.width / tex.getSize().x, b.rect.height / tex.getSize().y);
+        billboard.setPosition(b.rect.left, b.rect.top);
+        target.draw(billboard);
+        count(1, 4);
+    }
+
+    void fillRect(sf::FloatRect rect, sf::Color color) override {
+        shape.setSize(sf::Vector2f(rect.width, rect.height));
+        shape.setPosition(rect.left, rect.top);
+        shape.setFillColor(color);
+        target.draw(shape);
+        count(1, 4);
+    }
+
+    void drawPlayer(sf::Vector2f position, float rotation) override {
+        player.setPosition(position);
+        player.setRotation(rotation);
+        target.draw(player);
+        count(1, 4);
+    }
+
+    void drawHud(const FrameSnapshot& frame) override {
+        hud.update(frame);
+        count(hud.draw(target), 4);
+    }
+
+private:
+    // Sprites and shapes are one quad each; HUD text is counted per draw call the same
+    // way, so its vertex count is a lower bound
+    void count(int calls, int verticesPerCall) {
+        stats.drawCalls += calls;
+        stats.vertices += std::uint64_t(calls) * verticesPerCall;
+    }
+
+    sf::RenderTarget& target;
+    TiledPanorama& background;
+    ImpostorLayer& farScenery;
+    const sf::Texture* opponentTextures;
+    const sf::Texture* sceneryTextures;
+    Hud& hud;
+
+    sf::Sprite billboard;
+    sf::RectangleShape shape;
+    sf::RectangleShape player;
+};
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <vector>
+#include "GameConfig.h"
+#include "FrameArena.h"
+#include "FrameSnapshot.h"
+#include "GameOptions.h"
+#include "GameRules.h"
+#include "InputLog.h"
+#include "InputQueue.h"
+#include "QualityGovernor.h"
+#include "Timing.h"
+#include "Track.h"
+#include "TrackGenerator.h"
+
+// Running totals of the frame builder's road work
+struct SimStats {
+    std::uint64_t ticks = 0;
+    std::uint64_t projectedSegments = 0;
+    std::uint64_t roadSegments = 0;
+    std::uint64_t mergedSegments = 0;
+};
+
+// All game rules: steering, boost, spawning, collisions. Owns the track and
+// produces one FrameSnapshot per fixed tick. Touches no window, texture or sound.
+class Simulation {
+public:
+    Simulation(unsigned seed, const SpriteSizes& sizes, const GameOptions& options)
+        : rand(seed), sprites(sizes), tickArena(64 * 1024),
+          farSceneryDistance(float(options.impostorSplitSegments * SEG_LEN)),
+          lateInput(options.lateInput), stressScene(options.stressScene), trackSeed(seed) {
+        generateTrack(lines, TRACK_SEGMENTS, trackKey(), sprites.hasScenery);
+
+        // Highest point of the track, for the horizon test
+        buildViewMaxY(lines, VIEW_SEGMENTS, viewMaxY);
+    }
+
+    // Only read once the simulation thread has stopped
+    const SimStats& stats() const { return statTotals; }
+
+    // Safe to call from any thread; picked up at the next tick
+    void setQualityLevel(int level) { qualityLevel.store(level, std::memory_order_relaxed); }
+
+    // Every event goes through here, in order, before the tick it belongs to
+    void handleInput(const InputEvent& e) {
+        if (e.key < 0 || e.key >= sf::Keyboard::KeyCount) return;
+
+        // Key repeat: a press of a key that is already down is not a new press
+        if (e.pressed == keyHeld[e.key]) return;
+        keyHeld[e.key] = e.pressed;
+
+        if (recording) {
+            // Recording is off the render path, so the log grows rather than dropping
+            // input; growths are counted for the steady-state allocation checks
+            if (recording->events.size() == recording->events.capacity()) {
+                recordingGrowths.fetch_add(1, std::memory_order_relaxed);
+            }
+            InputEvent logged = e;
+            logged.tick = nextTick();
+            recording->events.push_back(logged);
+        }
+        if (!e.pressed) return;
+
+        if (player.isOver && e.key == sf::Keyboard::Y) {
+            restart();
+        }
+        else if (applyAction(player, actionFor(e.key))) {
+            if (e.key == sf::Keyboard::Space) boostCue++;
+            inputApplied(e.timeUs);
+        }
+    }
+
+    // Apply every event due on the next tick, then advance one tick and write what
+    // the renderer needs into `out`
+    void tick(FrameSnapshot& out, InputQueue& input, std::int64_t tickStartUs) {
+        InputEvent e;
+        while (input.popDue(nextTick(), tickStartUs, e)) {
+            // Late input owns the steering keys: the window's copy of an edge can arrive
+            // after sampling has already seen both the press and the release of a short
+            // tap, and would then count as a second press
+            if (lateInput && isSteeringKey(e.key)) continue;
+            handleInput(e);
+        }
+        if (lateInput) sampleSteering();
+        tick(out);
+    }
+
+    void tick(FrameSnapshot& out) {
+        tickArena.reset();
+        tickCount++;
+        if (!player.isOver) step();
+        buildFrame(out);
+    }
+
+    std::uint64_t nextTick() const { return tickCount + 1; }
+
+    // Log every press from now on, tagged with its tick; `log` must outlive the simulation
+    void record(InputLog* log) {
+        recording = log;
+        recording->seed = trackSeed;
+        recording->events.reserve(1 << 16);
+    }
+
+    // Times the recording outgrew its reservation, one heap allocation each; safe from any thread
+    std::uint64_t recordingGrowthCount() const { return recordingGrowths.load(std::memory_order_relaxed); }
+
+    // Final tick count goes into the log so a replay stops at the same point
+    void finishRecording() {
+        if (recording) recording->ticks = tickCount;
+    }
+
+    // Fingerprint of the game state, for checking that a replay matches its recording
+    std::uint64_t checksum() const {
+        std::uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](std::uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+        mix(tickCount);
+        mix(std::uint64_t(player.pos));
+        mix(std::uint64_t(player.playerLane));
+        mix(std::uint64_t(player.score));
+        mix(std::uint64_t(player.boostsLeft));
+        mix(std::uint64_t(player.isOver));
+        for (const Line& l : lines) {
+            if (l.hasOpponent) mix(std::uint64_t(&l - lines.data()) * 4 + std::uint64_t(l.opponentLane));
+        }
+        return h;
+    }
+
+    // Track segments held in memory, for the memory report
+    std::size_t trackCapacity() const { return lines.capacity(); }
+
+    int currentScore() const { return player.score; }
+    bool gameOver() const { return player.isOver; }
+
+private:
+    struct VisibleOpponent {
+        sf::FloatRect bounds;
+        int lane;
+    };
+
+    static PlayerAction actionFor(sf::Keyboard::Key key) {
+        if (key == sf::Keyboard::Left || key == sf::Keyboard::A) return ACTION_LEFT;
+        if (key == sf::Keyboard::Right || key == sf::Keyboard::D) return ACTION_RIGHT;
+        if (key == sf::Keyboard::Space) return ACTION_BOOST;
+        return ACTION_NONE;
+    }
+
+    void inputApplied(std::int64_t timeUs) {
+        inputSeq++;
+        inputTimeUs = timeUs;
+    }
+
+    static constexpr sf::Keyboard::Key STEERING_KEYS[] = { sf::Keyboard::Left, sf::Keyboard::A, sf::Keyboard::Right, sf::Keyboard::D };
+
+    static bool isSteeringKey(sf::Keyboard::Key key) {
+        for (sf::Keyboard::Key k : STEERING_KEYS) {
+            if (k == key) return true;
+        }
+        return false;
+    }
+
+    // Late input: read the steering keys right before the step instead of waiting
+    // for the render thread to poll and forward them. Edges become ordinary events;
+    // the window's copies of them are dropped in tick().
+    void sampleSteering() {
+        std::int64_t now = steadyMicros();
+        for (sf::Keyboard::Key k : STEERING_KEYS) {
+            bool down = sf::Keyboard::isKeyPressed(k);
+            if (down != keyHeld[k]) handleInput({ k, down, now });
+        }
+    }
+
+    // Stable per-segment pick so thinned-out scenery doesn't flicker
+    static bool keepScenery(int segment, int densityPct) {
+        return densityPct >= 100 || int((unsigned(segment) * 2654435761u) >> 16) % 100 < densityPct;
+    }
+
+    void restart() {
+        resetPlayer(player);
+
+        // Reset opponents and scenery - a new layout for every race on this seed
+        trackGeneration++;
+        generateTrack(lines, TRACK_SEGMENTS, trackKey(), sprites.hasScenery);
+
+        restartCue++;
+    }
+
+    TrackKey trackKey() const {
+        return { trackSeed, trackGeneration, stressScene ? &STRESS_SPAWNS : &TRACK_SPAWNS };
+    }
+
+    void step() {
+        const int N = int(lines.size());
+        advancePlayer(player, N);
+        spawnOpponents(player, N, rand,
+            [this](int i) { return lines[i].hasOpponent; },
+            [this](int i) { placeOpponent(lines[i], rand); });
+    }
+
+    void buildFrame(FrameSnapshot& out) {
+        const int N = int(lines.size());
+
+        out.tick = tickCount;
+        out.pos = player.pos;
+        out.playerX = player.playerX;
+        out.targetX = player.targetX;
+        out.score = player.score;
+        out.speed = player.speed;
+        out.boostsLeft = player.boostsLeft;
+        out.isBoosting = player.isBoosting;
+        out.isOver = player.isOver;
+        out.segments.clear();
+        out.billboards.clear();
+        out.farBillboards.clear();
+        out.farSceneryKey = 1469598103934665603ull;
+        out.engines.clear();
+        out.projectedSegments = 0;
+        out.mergedSegments = 0;
+
+        if (!player.isOver) {
+            // Project road
+            int startPos = player.pos / SEG_LEN;
+            int camH = int(lines[startPos].y) + 1500;
+            int maxy = HEIGHT;
+            float x = 0, dx = 0;
+
+            const QualityLevel& quality = stressScene ? STRESS_QUALITY : QUALITY_LEVELS[qualityLevel.load(std::memory_order_relaxed)];
+            int viewEnd = startPos + quality.viewSegments;
+            int roadEnd = startPos + quality.roadSegments;
+            float sceneryRange = float(quality.scenerySegments * SEG_LEN);
+            float farScale = CAM_D / float(quality.viewSegments * SEG_LEN); // smallest scale in view
+
+            // Sub-pixel segments waiting to be merged into one quad
+            RoadSegment run;
+            bool hasRun = false;
+
+            // Project road segments from near to far - MAXIMUM RANGE for ultra-distant scenery
+            for (int n = startPos; n < viewEnd; n++) {
+                Line& l = lines[n % N];
+                l.project(int(player.playerX * ROAD_W / 2 - x), camH, startPos * SEG_LEN - (n >= N ? N * SEG_LEN : 0));
+                x += dx;
+                dx += l.curve;
+
+                // Horizon: stop once no further segment can show above the current clip line
+                if (pastHorizon(l.scale, farScale, viewMaxY[n % N] - camH, maxy)) {
+                    viewEnd = n;
+                    break;
+                }
+
+                l.clip = float(maxy);
+                if (l.Y >= maxy) continue;
+                maxy = int(l.Y);
+
+                const Line& p = (n > 0) ? lines[(n - 1) % N] : l;
+                if (n >= roadEnd) continue;
+
+                RoadSegment seg;
+                seg.x1 = p.X; seg.y1 = p.Y; seg.w1 = p.W;
+                seg.x2 = l.X; seg.y2 = l.Y; seg.w2 = l.W;
+                seg.isDark = ((n / 3) % 2) == 0; // Alternate segment colors for road effect
+
+                // Distant slivers: extend one quad until it is at least a pixel tall
+                if (seg.y1 - seg.y2 < LOD_MERGE_HEIGHT) {
+                    if (hasRun) {
+                        run.x2 = seg.x2; run.y2 = seg.y2; run.w2 = seg.w2;
+                        out.mergedSegments++;
+                    }
+                    else {
+                        run = seg;
+                        hasRun = true;
+                    }
+                    if (run.y1 - run.y2 >= LOD_MERGE_HEIGHT) {
+                        out.segments.push_back(run);
+                        hasRun = false;
+                    }
+                    continue;
+                }
+                if (hasRun) {
+                    out.segments.push_back(run);
+                    hasRun = false;
+                }
+
+                seg.laneMarks = !seg.isDark && seg.w1 * LANE_MARK_WIDTH >= LANE_MARK_MIN_WIDTH;
+                out.segments.push_back(seg);
+            }
+            if (hasRun) out.segments.push_back(run);
+            out.projectedSegments = viewEnd - startPos;
+
+            // Lay out scenery and opponents
+            ArenaVector<VisibleOpponent> visibleOpponents(tickArena, OPPONENT_DRAW_SEGMENTS);
+            for (int n = startPos; n < viewEnd; n++) {
+                const Line& l = lines[n % N];
+
+                // Scenery first (behind cars) - allow ultra-distant scenery
+                if (l.hasScenery && l.Y < HEIGHT + 200 && l.Y > -300 // Ultra-generous Y bounds
+                    && std::abs(l.z - player.pos) <= sceneryRange && keepScenery(n % N, quality.sceneryDensity)) {
+                    bool farField = farSceneryDistance > 0 && std::abs(l.z - player.pos) > farSceneryDistance;
+                    std::size_t farCount = out.farBillboards.size();
+                    l.layoutScenery(farField ? out.farBillboards : out.billboards, player.pos, sprites.scenery[l.sceneryType]);
+                    if (out.farBillboards.size() != farCount) {
+                        out.farSceneryKey = (out.farSceneryKey ^ std::uint64_t(n % N + 1)) * 1099511628211ull;
+                    }
+                }
+
+                // Only process opponents in closer range for performance
+                if (n < startPos + OPPONENT_DRAW_SEGMENTS && l.hasOpponent && l.Y < HEIGHT && l.Y > -100) {
+                    // Past the last road quad a car would float over the grass: it still
+                    // takes part in collisions, but isn't drawn
+                    sf::FloatRect oppBounds = n < roadEnd
+                        ? l.layoutOpponent(out.billboards, player.pos, sprites.opponent[l.opponentType])
+                        : l.opponentRect(player.pos, sprites.opponent[l.opponentType]);
+                    if (oppBounds.width > 0) {
+                        visibleOpponents.push_back({ oppBounds, l.opponentLane });
+                    }
+                }
+            }
+
+            // Engine sound sources: every opponent in earshot, hidden behind a hill or not
+            for (int n = startPos + 1; n < startPos + OPPONENT_AUDIO_SEGMENTS; n++) {
+                const Line& l = lines[n % N];
+                if (!l.hasOpponent) continue;
+
+                EngineSource source;
+                source.id = n % N;
+                source.type = l.opponentType;
+                // Lane center in road half-widths, as layoutOpponent places the sprite
+                float laneCenter = -1 + (2.f * l.opponentLane + 1 + l.opponentOffset * 0.5f) / NUM_LANES;
+                source.lateral = laneCenter - player.playerX;
+                source.distance = float((n - startPos) * SEG_LEN - player.pos % SEG_LEN);
+                out.engines.push_back(source);
+            }
+
+            // Check collisions with all visible opponents
+            sf::FloatRect playerRect = playerCollisionRect(player.playerX);
+
+            for (const VisibleOpponent& opp : visibleOpponents) {
+                // Check if in same lane and rectangles overlap
+                if (opp.lane == player.playerLane && playerRect.intersects(opp.bounds)) {
+                    // The stress scene has to stay full for as long as it is measured
+                    if (stressScene) break;
+                    player.isOver = true;
+                    crashCue++;
+                    break;
+                }
+            }
+        }
+
+        statTotals.ticks++;
+        statTotals.projectedSegments += out.projectedSegments;
+        statTotals.roadSegments += out.segments.size();
+        statTotals.mergedSegments += out.mergedSegments;
+
+        out.inputSeq = inputSeq;
+        out.inputTimeUs = inputTimeUs;
+        out.boostCue = boostCue;
+        out.crashCue = crashCue;
+        out.restartCue = restartCue;
+    }
+
+    std::vector<Line> lines;
+    TrackRandom rand;
+    SpriteSizes sprites;
+    FrameArena tickArena;  // scratch memory for one tick
+    std::vector<float> viewMaxY;  // highest road point within view of each segment
+    float farSceneryDistance;  // world units; scenery beyond goes to the impostor layer
+    std::atomic<int> qualityLevel{ QUALITY_LEVEL_COUNT - 1 };
+    SimStats statTotals;
+    bool keyHeld[sf::Keyboard::KeyCount] = {};
+    bool lateInput;
+    bool stressScene;  // --stress: every segment populated, full view, no crashes
+    unsigned trackSeed;
+    unsigned trackGeneration = 0;  // races started on this seed before the current one
+    InputLog* recording = nullptr;
+    std::atomic<std::uint64_t> recordingGrowths{ 0 };
+    unsigned inputSeq = 0;
+    std::int64_t inputTimeUs = 0;
+
+    // Game variables
+    std::uint64_t tickCount = 0;
+    PlayerState player;
+
+    unsigned boostCue = 0;
+    unsigned crashCue = 0;
+    unsigned restartCue = 0;
+};
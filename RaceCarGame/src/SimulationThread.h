@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "FrameSnapshot.h"
+#include "InputQueue.h"
+#include "Simulation.h"
+#include "TripleBuffer.h"
+
+// Runs a Simulation at SIM_TICK_HZ on its own thread so a slow display() or vsync
+// stall never delays game logic. Input goes in through `input`, frames come out through `frames`.
+class SimulationThread {
+public:
+    explicit SimulationThread(Simulation& simulation) : sim(simulation) {
+        frames.forEachSlot([](FrameSnapshot& f) { f.reserve(); });
+    }
+
+    ~SimulationThread() { stop(); }
+
+    void start() {
+        running = true;
+        thread = std::thread(&SimulationThread::run, this);
+    }
+
+    void stop() {
+        running = false;
+        if (thread.joinable()) thread.join();
+    }
+
+    InputQueue input;                    // render thread (or a replay script) -> simulation
+    TripleBuffer<FrameSnapshot> frames;  // simulation -> render thread
+
+private:
+    void run() {
+        using clock = std::chrono::steady_clock;
+        const clock::duration tickLength = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(1.0 / SIM_TICK_HZ));
+
+        clock::time_point next = clock::now();
+        while (running) {
+            // Input polled before this tick was due belongs to it, however late the thread woke up
+            std::int64_t tickStartUs = std::chrono::duration_cast<std::chrono::microseconds>(next.time_since_epoch()).count();
+            sim.tick(frames.writeBuffer(), input, tickStartUs);
+            frames.publish();
+
+            next += tickLength;
+            // Fell far behind (debugger, window drag): resync instead of running a burst of ticks
+            if (clock::now() - next > tickLength * 5) next = clock::now();
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    Simulation& sim;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+};
@@ -0,0 +1,459 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFTWARE_RENDERER_SSE2 1
+#endif
+#include "GameConfig.h"
+#include "BillboardTextures.h"
+#include "FrameRenderer.h"
+
+// RGBA8 pixels in sf::Image byte order, always opaque. Everything is drawn with
+// alpha blending (src * a + dst * (1 - a)); solid and sprite spans go through SSE2 when
+// available, with the same rounding as the scalar path.
+class Framebuffer {
+public:
+    Framebuffer(int width, int height) : w(width), h(height), pixelData(std::size_t(width) * height) {}
+
+    int width() const { return w; }
+    int height() const { return h; }
+    const sf::Uint8* pixels() const { return reinterpret_cast<const sf::Uint8*>(pixelData.data()); }
+
+    void clear(sf::Color c) {
+        c.a = 255;
+        std::fill(pixelData.begin(), pixelData.end(), pack(c));
+    }
+
+    // Pixels [x0, x1) of row y in a solid color
+    void fillSpan(int y, int x0, int x1, sf::Color c) {
+        if (y < 0 || y >= h) return;
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, w);
+        if (x0 >= x1 || c.a == 0) return;
+
+        std::uint32_t* p = &pixelData[std::size_t(y) * w + x0];
+        int n = x1 - x0;
+        if (c.a == 255) fillOpaque(p, n, pack(c));
+        else blendSolid(p, n, c);
+    }
+
+    // Pixel centers inside the triangle are covered, so triangles sharing an edge
+    // (the two halves of a road quad) neither overlap nor leave a gap
+    void fillTriangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+        if (a.y > b.y) std::swap(a, b);
+        if (b.y > c.y) std::swap(b, c);
+        if (a.y > b.y) std::swap(a, b);
+        if (c.y <= a.y) return;
+
+        int yStart = std::max(0, int(std::ceil(a.y - 0.5f)));
+        int yEnd = std::min(h, int(std::ceil(c.y - 0.5f)));
+        for (int y = yStart; y < yEnd; y++) {
+            float yc = y + 0.5f;
+            float xLong = a.x + (c.x - a.x) * (yc - a.y) / (c.y - a.y);
+            float xShort = yc < b.y ? a.x + (b.x - a.x) * (yc - a.y) / (b.y - a.y)
+                                    : b.x + (c.x - b.x) * (yc - b.y) / (c.y - b.y);
+            float left = std::min(xLong, xShort), right = std::max(xLong, xShort);
+            fillSpan(y, int(std::ceil(left - 0.5f)), int(std::ceil(right - 0.5f)), color);
+        }
+    }
+
+    void fillRect(sf::FloatRect r, sf::Color color) {
+        int x0 = int(std::ceil(r.left - 0.5f)), x1 = int(std::ceil(r.left + r.width - 0.5f));
+        int y0 = std::max(0, int(std::ceil(r.top - 0.5f))), y1 = std::min(h, int(std::ceil(r.top + r.height - 0.5f)));
+        for (int y = y0; y < y1; y++) fillSpan(y, x0, x1, color);
+    }
+
+    // Scale `image` into `dest`, nearest texel, blended by texel alpha times `opacity`
+    void blit(const sf::Image& image, sf::FloatRect dest, sf::Uint8 opacity = 255) {
+        sf::Vector2u size = image.getSize();
+        if (size.x == 0 || size.y == 0 || dest.width <= 0 || dest.height <= 0) return;
+
+        int x0 = std::max(0, int(std::ceil(dest.left - 0.5f))), x1 = std::min(w, int(std::ceil(dest.left + dest.width - 0.5f)));
+        int y0 = std::max(0, int(std::ceil(dest.top - 0.5f))), y1 = std::min(h, int(std::ceil(dest.top + dest.height - 0.5f)));
+        if (x0 >= x1 || y0 >= y1) return;
+
+        const std::uint32_t* texels = reinterpret_cast<const std::uint32_t*>(image.getPixelsPtr());
+        float du = size.x / dest.width, dv = size.y / dest.height;
+        std::uint32_t run[SPAN_RUN];
+        for (int y = y0; y < y1; y++) {
+            unsigned v = std::min(size.y - 1, unsigned((y + 0.5f - dest.top) * dv));
+            const std::uint32_t* row = texels + std::size_t(v) * size.x;
+            std::uint32_t* p = &pixelData[std::size_t(y) * w];
+            // Sample a run of texels, then blend the run in one go
+            for (int x = x0; x < x1; x += SPAN_RUN) {
+                int n = std::min(SPAN_RUN, x1 - x);
+                for (int i = 0; i < n; i++) {
+                    run[i] = row[std::min(size.x - 1, unsigned((x + i + 0.5f - dest.left) * du))];
+                }
+                blendSpan(p + x, run, n, opacity);
+            }
+        }
+    }
+
+    // Draw `image` stretched over a `size` rectangle rotated `degrees` about `origin`
+    // (in the rectangle's own coordinates) and placed at `position`, like sf::RectangleShape
+    void blitRotated(const sf::Image& image, sf::Vector2f position, sf::Vector2f size, sf::Vector2f origin, float degrees) {
+        sf::Vector2u texSize = image.getSize();
+        if (texSize.x == 0 || texSize.y == 0) return;
+
+        float angle = degrees * 3.14159265f / 180.f;
+        float cs = std::cos(angle), sn = std::sin(angle);
+
+        // Screen bounding box of the rotated rectangle
+        float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f;
+        for (int i = 0; i < 4; i++) {
+            float lx = (i & 1 ? size.x : 0) - origin.x, ly = (i & 2 ? size.y : 0) - origin.y;
+            float sx = position.x + lx * cs - ly * sn, sy = position.y + lx * sn + ly * cs;
+            minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+            minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+        }
+        int x0 = std::max(0, int(minX)), x1 = std::min(w, int(std::ceil(maxX)));
+        int y0 = std::max(0, int(minY)), y1 = std::min(h, int(std::ceil(maxY)));
+
+        const std::uint32_t* texels = reinterpret_cast<const std::uint32_t*>(image.getPixelsPtr());
+        std::uint32_t run[SPAN_RUN];
+        for (int y = y0; y < y1; y++) {
+            std::uint32_t* p = &pixelData[std::size_t(y) * w];
+            for (int x = x0; x < x1; x += SPAN_RUN) {
+                int n = std::min(SPAN_RUN, x1 - x);
+                for (int i = 0; i < n; i++) {
+                    // Back into the rectangle's coordinates; outside it is a transparent texel
+                    float dx = x + i + 0.5f - position.x, dy = y + 0.5f - position.y;
+                    float lx = dx * cs + dy * sn + origin.x, ly = -dx * sn + dy * cs + origin.y;
+                    if (lx < 0 || ly < 0 || lx >= size.x || ly >= size.y) {
+                        run[i] = 0;
+                        continue;
+                    }
+                    unsigned u = unsigned(lx / size.x * texSize.x), v = unsigned(ly / size.y * texSize.y);
+                    run[i] = texels[std::size_t(v) * texSize.x + u];
+                }
+                blendSpan(p + x, run, n, 255);
+            }
+        }
+    }
+
+    bool savePng(const std::string& path) const {
+        sf::Image image;
+        image.create(unsigned(w), unsigned(h), pixels());
+        return image.saveToFile(path);
+    }
+
+private:
+    static std::uint32_t pack(sf::Color c) {
+        sf::Uint8 bytes[4] = { c.r, c.g, c.b, c.a };
+        std::uint32_t v;
+        std::memcpy(&v, bytes, 4);
+        return v;
+    }
+
+    static const std::uint32_t& alphaMask() {
+        static const std::uint32_t mask = pack(sf::Color(0, 0, 0, 255));
+        return mask;
+    }
+
+    // x / 255 rounded, for x = product sum + 128
+    static sf::Uint8 div255(unsigned x) {
+        return sf::Uint8((x + (x >> 8)) >> 8);
+    }
+
+    static void fillOpaque(std::uint32_t* p, int n, std::uint32_t value) {
+        int i = 0;
+#ifdef SOFTWARE_RENDERER_SSE2
+        __m128i v = _mm_set1_epi32(int(value));
+        for (; i + 4 <= n; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), v);
+#endif
+        for (; i < n; i++) p[i] = value;
+    }
+
+    // dst = (src * a + dst * (255 - a)) / 255 per channel, rounded; alpha stays 255
+    static void blendSolid(std::uint32_t* p, int n, sf::Color c) {
+        unsigned a = c.a, inv = 255 - a;
+        int i = 0;
+#ifdef SOFTWARE_RENDERER_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i invV = _mm_set1_epi16(short(inv));
+        const __m128i srcTerm = _mm_setr_epi16(
+            short(c.r * a + 128), short(c.g * a + 128), short(c.b * a + 128), short(255 * a + 128),
+            short(c.r * a + 128), short(c.g * a + 128), short(c.b * a + 128), short(255 * a + 128));
+        const __m128i mask = _mm_set1_epi32(int(alphaMask()));
+        for (; i + 4 <= n; i += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i lo = _mm_unpacklo_epi8(px, zero), hi = _mm_unpackhi_epi8(px, zero);
+            lo = _mm_add_epi16(_mm_mullo_epi16(lo, invV), srcTerm);
+            hi = _mm_add_epi16(_mm_mullo_epi16(hi, invV), srcTerm);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);  // exact /255 for t + 128
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), _mm_or_si128(_mm_packus_epi16(lo, hi), mask));
+        }
+#endif
+        const unsigned src[3] = { c.r * a + 128u, c.g * a + 128u, c.b * a + 128u };
+        for (; i < n; i++) {
+            sf::Uint8* d = reinterpret_cast<sf::Uint8*>(p + i);
+            for (int ch = 0; ch < 3; ch++) d[ch] = div255(d[ch] * inv + src[ch]);
+            d[3] = 255;
+        }
+    }
+
+    // Texels sampled into a stack buffer per blend call
+    static constexpr int SPAN_RUN = 64;
+
+    // p[i] = blendTexel(p[i], src[i], opacity) for n pixels. Alpha is per texel, so each
+    // pixel's weight is broadcast across its channels; a = 0 and a = 255 come out exact
+    // without branches, matching blendTexel's shortcuts.
+    static void blendSpan(std::uint32_t* p, const std::uint32_t* src, int n, sf::Uint8 opacity) {
+        int i = 0;
+#ifdef SOFTWARE_RENDERER_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i opacityV = _mm_set1_epi16(short(opacity));
+        const __m128i full = _mm_set1_epi16(255);
+        const __m128i round127 = _mm_set1_epi16(127), round128 = _mm_set1_epi16(128), one = _mm_set1_epi16(1);
+        const __m128i mask = _mm_set1_epi32(int(alphaMask()));
+        auto blend = [&](__m128i s, __m128i d) {
+            // a = (texel alpha * opacity + 127) / 255, floor division done as (t + 1 + (t >> 8)) >> 8
+            __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            a = _mm_add_epi16(_mm_mullo_epi16(a, opacityV), round127);
+            a = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(a, one), _mm_srli_epi16(a, 8)), 8);
+            __m128i t = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a))), round128);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+        for (; i + 4 <= n; i += 4) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i lo = blend(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+            __m128i hi = blend(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), _mm_or_si128(_mm_packus_epi16(lo, hi), mask));
+        }
+#endif
+        for (; i < n; i++) blendTexel(p[i], src[i], opacity);
+    }
+
+    static void blendTexel(std::uint32_t& dst, std::uint32_t texel, sf::Uint8 opacity) {
+        const sf::Uint8* s = reinterpret_cast<const sf::Uint8*>(&texel);
+        unsigned a = (s[3] * opacity + 127) / 255;
+        if (a == 0) return;
+        if (a == 255) {
+            dst = texel;
+            return;
+        }
+        sf::Uint8* d = reinterpret_cast<sf::Uint8*>(&dst);
+        unsigned inv = 255 - a;
+        for (int ch = 0; ch < 3; ch++) d[ch] = div255(s[ch] * a + d[ch] * inv + 128);
+        d[3] = 255;
+    }
+
+    int w, h;
+    std::vector<std::uint32_t> pixelData;
+};
+
+// An image with its mip chain, for drawing minified on the CPU
+struct SoftwareImage {
+    std::vector<sf::Image> levels;
+
+    bool load(const std::string& path) {
+        sf::Image image;
+        if (!image.loadFromFile(path)) return false;
+        build(image);
+        return true;
+    }
+
+    void build(const sf::Image& image) {
+        levels.clear();
+        levels.push_back(image);
+        while (levels.back().getSize().x > 1 && levels.back().getSize().y > 1) {
+            levels.push_back(halveImage(levels.back()));
+        }
+    }
+
+    bool isLoaded() const { return !levels.empty(); }
+
+    std::uint64_t bytes() const {
+        std::uint64_t total = 0;
+        for (const sf::Image& level : levels) total += std::uint64_t(level.getSize().x) * level.getSize().y * 4;
+        return total;
+    }
+    sf::Vector2u size() const { return levels.empty() ? sf::Vector2u() : levels[0].getSize(); }
+
+    // Smallest level still at least `width` texels wide
+    const sf::Image& levelFor(float width) const {
+        std::size_t l = 0;
+        while (l + 1 < levels.size() && levels[l + 1].getSize().x >= width) l++;
+        return levels[l];
+    }
+};
+
+// Renders frames into a Framebuffer with no OpenGL context or display. Loads its own
+// CPU copies of the images; the HUD uses a built-in pixel font instead of the TTF fonts.
+class SoftwareBackend : public RenderBackend {
+public:
+    SoftwareBackend() : target(WIDTH, HEIGHT) {}
+
+    // `playerImage` is the selected car's image file
+    bool load(const std::string& playerImage) {
+        bool ok = player.load(playerImage);
+        const char* opponentPaths[2] = { "images/8.png", "images/2nd.png" };
+        for (int i = 0; i < 2; i++) {
+            if (!opponents[i].load(opponentPaths[i])) opponents[i] = player;
+        }
+        const char* sceneryPaths[4] = { "images/4.png", "images/5.png", "images/7.png", "images/6.png" };
+        for (int i = 0; i < 4; i++) ok = scenery[i].load(sceneryPaths[i]) && ok;
+
+        sf::Image sky;
+        if (sky.loadFromFile("images/bg4.png")) {
+            // Only the rows the game shows, like TiledPanorama
+            panoramaHeight = std::min(int(HEIGHT * 0.6), int(sky.getSize().y));
+            panorama.create(sky.getSize().x, unsigned(panoramaHeight));
+            panorama.copy(sky, 0, 0, sf::IntRect(0, 0, int(sky.getSize().x), panoramaHeight));
+        }
+        hasBoosterUI = boosterIcon.loadFromFile("images/boostericon.png") && boosterText.loadFromFile("images/boostertext.png");
+        return ok;
+    }
+
+    const Framebuffer& framebuffer() const { return target; }
+
+    // CPU copies of the images, mip chains included
+    std::uint64_t imageBytes() const {
+        std::uint64_t total = player.bytes() + opponents[0].bytes() + opponents[1].bytes();
+        for (const SoftwareImage& s : scenery) total += s.bytes();
+        for (const sf::Image* image : { &panorama, &boosterIcon, &boosterText }) {
+            total += std::uint64_t(image->getSize().x) * image->getSize().y * 4;
+        }
+        return total;
+    }
+
+    void clear(sf::Color color) override {
+        target.clear(color);
+        count(1, 0);
+    }
+
+    void drawBackground(float playerX) override {
+        if (panorama.getSize().x == 0) return;
+        int pan = panoramaPan(int(panorama.getSize().x), playerX);
+        target.blit(panorama, sf::FloatRect(float(-pan), 0, float(panorama.getSize().x), float(panoramaHeight)));
+        count(1, 4);
+    }
+
+    // Every vertex of a drawQuad triangle has the same color, so triangles are flat-shaded
+    void drawTriangles(const sf::Vertex* v, std::size_t n) override {
+        for (std::size_t i = 0; i + 2 < n; i += 3) {
+            target.fillTriangle(v[i].position, v[i + 1].position, v[i + 2].position, v[i].color);
+        }
+        count(1, n);
+    }
+
+    // No impostor: far scenery is cheap to rasterize directly
+    void drawFarScenery(const FrameSnapshot& frame) override {
+        for (const Billboard& b : frame.farBillboards) drawBillboard(b);
+    }
+
+    void drawBillboard(const Billboard& b) override {
+        const SoftwareImage& image = (b.kind == OPPONENT_BILLBOARD) ? opponents[b.texture] : scenery[b.texture];
+        if (!image.isLoaded()) return;
+        target.blit(image.levelFor(b.rect.width), b.rect);
+        count(1, 4);
+    }
+
+    void fillRect(sf::FloatRect rect, sf::Color color) override {
+        target.fillRect(rect, color);
+        count(1, 4);
+    }
+
+    void drawPlayer(sf::Vector2f position, float rotation) override {
+        if (!player.isLoaded()) return;
+        target.blitRotated(player.levelFor(PLAYER_SIZE.x), position, PLAYER_SIZE, sf::Vector2f(PLAYER_SIZE.x / 2, PLAYER_SIZE.y / 2), rotation);
+        count(1, 4);
+    }
+
+    // Same layout as Hud: score and speed on the left, booster counter on the right
+    void drawHud(const FrameSnapshot& frame) override {
+        char line[64];
+        std::snprintf(line, sizeof(line), "SCORE: %d", frame.score);
+        drawText(line, 10, 10, sf::Color::Yellow);
+        std::snprintf(line, sizeof(line), "SPEED: %d KM/H%s", frame.speed, frame.isBoosting ? " [BOOSTING!]" : "");
+        drawText(line, 10, 40, sf::Color::Cyan);
+
+        if (hasBoosterUI) {
+            const int MAX_BOOSTERS = 3;
+            float iconW = float(boosterIcon.getSize().x), iconH = float(boosterIcon.getSize().y);
+            float textW = float(boosterText.getSize().x), textH = float(boosterText.getSize().y);
+            float textX = WIDTH - 10.f - MAX_BOOSTERS * iconW / 2.f - textW / 2.f, textY = 4.f;
+            target.blit(boosterText, sf::FloatRect(textX, textY, textW, textH));
+            float baseX = textX + textW / 2.f - MAX_BOOSTERS * iconW / 2.f;
+            for (int i = 0; i < MAX_BOOSTERS; i++) {
+                target.blit(boosterIcon, sf::FloatRect(baseX + i * iconW, textY + textH, iconW, iconH), i < frame.boostsLeft ? 255 : 80);
+            }
+            count(1 + MAX_BOOSTERS, 4 * (1 + MAX_BOOSTERS));
+        }
+    }
+
+private:
+    static const int GLYPH_SCALE = 3;
+
+    void count(int calls, std::size_t vertices) {
+        stats.drawCalls += calls;
+        stats.vertices += vertices;
+    }
+
+    // 5x7 pixel font, top row first, bit 4 = leftmost column; just the HUD's characters
+    static const sf::Uint8* glyph(char ch) {
+        static const struct { char ch; sf::Uint8 rows[7]; } font[] = {
+            { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } }, { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+            { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } }, { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+            { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } }, { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+            { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } }, { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+            { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } }, { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+            { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } }, { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+            { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } }, { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+            { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } }, { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+            { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } }, { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+            { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } }, { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+            { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } }, { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+            { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } }, { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+            { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } }, { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+            { '/', { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 } }, { '!', { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 } },
+            { '[', { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E } }, { ']', { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E } },
+        };
+        for (const auto& g : font) {
+            if (g.ch == ch) return g.rows;
+        }
+        return nullptr;  // space and anything unknown
+    }
+
+    // Text with a one-pixel-cell black drop outline, like the HUD's outlined labels
+    void drawText(const char* text, float x, float y, sf::Color color) {
+        const float cell = float(GLYPH_SCALE);
+        for (int pass = 0; pass < 2; pass++) {
+            float penX = x;
+            for (const char* c = text; *c; c++) {
+                const sf::Uint8* rows = glyph(*c);
+                for (int r = 0; rows && r < 7; r++) {
+                    for (int col = 0; col < 5; col++) {
+                        if (!(rows[r] & (0x10 >> col))) continue;
+                        sf::FloatRect px(penX + col * cell, y + r * cell, cell, cell);
+                        if (pass == 0) target.fillRect(sf::FloatRect(px.left - 1, px.top - 1, cell + 2, cell + 2), sf::Color::Black);
+                        else target.fillRect(px, color);
+                    }
+                }
+                penX += 6 * cell;
+            }
+        }
+        count(1, 4 * std::strlen(text));
+    }
+
+    Framebuffer target;
+    SoftwareImage player;
+    SoftwareImage opponents[2];
+    SoftwareImage scenery[4];
+    sf::Image panorama;
+    int panoramaHeight = 0;
+    sf::Image boosterIcon, boosterText;
+    bool hasBoosterUI = false;
+};
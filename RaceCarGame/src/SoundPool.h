@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+
+// Effect priorities; a new effect may take over a voice playing one of equal or lower priority
+enum SoundPriority { PRIORITY_LOW = 0, PRIORITY_NORMAL = 1, PRIORITY_HIGH = 2 };
+
+// Fixed set of reusable sf::Sound voices for one-shot effects. When every voice is busy
+// the oldest lowest-priority one is stolen, and an effect that outranks nothing is dropped.
+class SoundPool {
+public:
+    static const int VOICES = 8;
+
+    // Attach `count` idle voices to `buffer` ahead of time. Attaching a buffer allocates
+    // inside SFML, so effects should find a voice already holding theirs during gameplay.
+    void reserveVoices(const sf::SoundBuffer& buffer, int count) {
+        for (int i = 0; i < VOICES && count > 0; i++) {
+            if (!voices[i].getBuffer()) {
+                voices[i].setBuffer(buffer);
+                count--;
+            }
+        }
+    }
+
+    // Returns false when the effect was dropped
+    bool play(const sf::SoundBuffer& buffer, SoundPriority priority, float volume = 100) {
+        int pick = -1, idle = -1;
+        for (int i = 0; i < VOICES; i++) {
+            if (voices[i].getStatus() != sf::Sound::Playing) {
+                if (voices[i].getBuffer() == &buffer) {
+                    idle = i;
+                    break;
+                }
+                if (idle < 0) idle = i;
+                continue;
+            }
+            if (priorities[i] <= priority && (pick < 0 || priorities[i] < priorities[pick]
+                || (priorities[i] == priorities[pick] && started[i] < started[pick]))) {
+                pick = i;
+            }
+        }
+        if (idle >= 0) {
+            pick = idle;
+        }
+        else if (pick < 0) {
+            dropped++;
+            return false;
+        }
+        else {
+            stolen++;
+        }
+
+        voices[pick].stop();
+        if (voices[pick].getBuffer() != &buffer) voices[pick].setBuffer(buffer);
+        voices[pick].setVolume(volume);
+        voices[pick].play();
+        priorities[pick] = priority;
+        started[pick] = ++playCount;
+        return true;
+    }
+
+    // Cut every voice playing `buffer`
+    void stop(const sf::SoundBuffer& buffer) {
+        for (sf::Sound& v : voices) {
+            if (v.getBuffer() == &buffer) v.stop();
+        }
+    }
+
+    std::uint64_t playedCount() const { return playCount; }
+    std::uint64_t stolenCount() const { return stolen; }
+    std::uint64_t droppedCount() const { return dropped; }
+
+private:
+    sf::Sound voices[VOICES];
+    SoundPriority priorities[VOICES] = {};
+    std::uint64_t started[VOICES] = {};
+    std::uint64_t playCount = 0;
+    std::uint64_t stolen = 0;
+    std::uint64_t dropped = 0;
+};
+
+// Startup cost and resident size of the game's audio
+struct AudioStats {
+    float decodeMs = 0;            // loading and decoding effects, opening streams
+    std::uint64_t bufferBytes = 0; // decoded PCM held in SoundBuffers
+    std::uint64_t streamBytes = 0; // streaming buffers of open sf::Music tracks
+
+    void addBuffer(const sf::SoundBuffer& buffer) {
+        bufferBytes += buffer.getSampleCount() * sizeof(sf::Int16);
+    }
+
+    // sf::Music decodes one second at a time into its own buffer and queues a few of
+    // them with the driver; count both
+    void addStream(const sf::Music& music) {
+        std::uint64_t second = std::uint64_t(music.getSampleRate()) * music.getChannelCount() * sizeof(sf::Int16);
+        streamBytes += second * (1 + MUSIC_QUEUED_BUFFERS);
+    }
+
+private:
+    static const int MUSIC_QUEUED_BUFFERS = 3;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Set a Text's string without touching the heap once `scratch` has grown to the longest string used
+inline void setTextString(sf::Text& text, sf::String& scratch, const char* s) {
+    scratch.clear();
+    for (; *s; ++s) scratch += sf::String(sf::Uint32(*s)); // single-char Strings stay in the small-string buffer
+    text.setString(scratch);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "GameConfig.h"
+
+// The sky panorama, cut into vertical tiles. Only the tiles under the current pan window
+// (plus a margin on each side) live on the GPU, in a fixed pool of slot textures; tiles
+// are uploaded as the window slides over them and their slot is reused once it has
+// moved on. The panorama can be wider than the GPU's maximum texture size, and only the
+// shown rows are kept at all.
+class TiledPanorama {
+public:
+    static constexpr int TILE_WIDTH = 256;
+    static constexpr int MARGIN = 256;  // pixels kept resident beyond each side of the window
+
+    // Keeps the top `visibleHeight` rows of the image in memory for later uploads
+    bool load(const std::string& path, int visibleHeight) {
+        sf::Image image;
+        if (!image.loadFromFile(path)) return false;
+
+        fullWidth = int(image.getSize().x);
+        height = std::min(visibleHeight, int(image.getSize().y));
+        fullBytes = std::uint64_t(image.getSize().x) * image.getSize().y * 4;
+        if (fullWidth <= 0 || height <= 0) return false;
+
+        pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + std::size_t(fullWidth) * height * 4);
+
+        tiles.clear();
+        for (int x = 0; x < fullWidth; x += TILE_WIDTH) {
+            Tile tile;
+            tile.x = x;
+            tile.width = std::min(TILE_WIDTH, fullWidth - x);
+            tiles.push_back(tile);
+        }
+
+        // Enough slots for the widest window however it is aligned to the tile grid
+        int slotCount = std::min(int(tiles.size()), (WIDTH + 2 * MARGIN) / TILE_WIDTH + 2);
+        slots.resize(slotCount);
+        for (Slot& slot : slots) {
+            if (!slot.texture.create(TILE_WIDTH, height)) return false;
+            slot.tile = -1;
+        }
+        staging.resize(std::size_t(TILE_WIDTH) * height * 4);
+        return true;
+    }
+
+    bool isLoaded() const { return !tiles.empty(); }
+    int width() const { return fullWidth; }
+
+    // Make the tiles around [panX, panX + WIDTH) resident and draw the window;
+    // returns the number of tiles drawn
+    int draw(sf::RenderTarget& target, int panX) {
+        int drawn = 0;
+        int left = panX - MARGIN, right = panX + WIDTH + MARGIN;
+
+        // Evict tiles the margin window has left
+        for (Slot& slot : slots) {
+            if (slot.tile >= 0 && !overlaps(tiles[slot.tile], left, right)) {
+                tiles[slot.tile].slot = -1;
+                slot.tile = -1;
+                evictions++;
+            }
+        }
+
+        for (int i = 0; i < int(tiles.size()); i++) {
+            Tile& tile = tiles[i];
+            if (!overlaps(tile, left, right)) continue;
+            if (tile.slot < 0) upload(i);
+            if (tile.slot < 0 || !overlaps(tile, panX, panX + WIDTH)) continue;
+
+            sprite.setTexture(slots[tile.slot].texture);
+            sprite.setTextureRect(sf::IntRect(0, 0, tile.width, height));
+            sprite.setPosition(float(tile.x - panX), 0);
+            target.draw(sprite);
+            drawn++;
+        }
+        return drawn;
+    }
+
+    unsigned long uploadCount() const { return uploads; }
+    unsigned long evictionCount() const { return evictions; }
+    std::uint64_t residentBytes() const { return std::uint64_t(slots.size()) * TILE_WIDTH * height * 4; }
+    std::uint64_t wholeTextureBytes() const { return fullBytes; }
+    // The shown rows kept in system memory for uploads
+    std::uint64_t sourceBytes() const { return pixels.capacity() + staging.capacity(); }
+
+private:
+    struct Tile {
+        int x = 0, width = 0;
+        int slot = -1;  // slot holding this tile, -1 = not resident
+    };
+
+    struct Slot {
+        sf::Texture texture;
+        int tile = -1;
+    };
+
+    static bool overlaps(const Tile& tile, int left, int right) {
+        return tile.x < right && tile.x + tile.width > left;
+    }
+
+    void upload(int index) {
+        for (int s = 0; s < int(slots.size()); s++) {
+            if (slots[s].tile >= 0) continue;
+
+            Tile& tile = tiles[index];
+            for (int y = 0; y < height; y++) {
+                std::memcpy(&staging[std::size_t(y) * tile.width * 4],
+                    &pixels[(std::size_t(y) * fullWidth + tile.x) * 4], std::size_t(tile.width) * 4);
+            }
+            slots[s].texture.update(staging.data(), unsigned(tile.width), unsigned(height), 0, 0);
+            slots[s].tile = index;
+            tile.slot = s;
+            uploads++;
+            return;
+        }
+    }
+
+    std::vector<sf::Uint8> pixels;   // the shown rows of the whole panorama, RGBA
+    std::vector<sf::Uint8> staging;  // one tile, packed for upload
+    std::vector<Tile> tiles;
+    std::vector<Slot> slots;
+    sf::Sprite sprite;
+    int fullWidth = 0;
+    int height = 0;
+    std::uint64_t fullBytes = 0;
+
+    unsigned long uploads = 0;
+    unsigned long evictions = 0;
+};
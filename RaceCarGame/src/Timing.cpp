@@ -0,0 +1,33 @@
+#include "Timing.h"
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+std::int64_t processCpuMicros() {
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) return 0;
+    auto micros = [](const FILETIME& t) {
+        return std::int64_t((std::uint64_t(t.dwHighDateTime) << 32 | t.dwLowDateTime) / 10);
+    };
+    return micros(kernel) + micros(user);
+}
+
+#else
+
+#include <sys/resource.h>
+
+std::int64_t processCpuMicros() {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return std::int64_t(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+        + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+#endif
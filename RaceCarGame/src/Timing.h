@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Microseconds on the monotonic clock; comparable across threads
+inline std::int64_t steadyMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time used so far by the whole process (every thread, user and kernel), in
+// microseconds. Defined in Timing.cpp so the platform headers stay out of the rest.
+std::int64_t processCpuMicros();
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "GameConfig.h"
+#include "FrameSnapshot.h"
+
+// Pixel sizes of the billboard textures, so layout can run without touching sf::Texture
+struct SpriteSizes {
+    sf::Vector2u opponent[2];
+    sf::Vector2u scenery[4];
+    bool hasScenery = false;
+};
+
+// One line/segment of the road
+struct Line {
+    float x = 0, y = 0, z = 0;       // 3D world coordinates
+    float X = 0, Y = 0, W = 0;       // screen coordinates
+    float clip = 0, scale = 0;
+    float curve = 0;                 // curve value for this segment
+    bool hasOpponent = false;
+    int opponentType = 0;            // Which opponent texture (0 or 1)
+    int opponentLane = 1;            // Which lane (0, 1, 2) the opponent is in
+    float opponentOffset = 0;        // Offset within the lane for variety
+
+    // Scenery objects
+    bool hasScenery = false;
+    int sceneryType = 0;             // 0=palm1, 1=palm2, 2=house, 3=grass
+    bool sceneryOnLeft = true;       // true=left side, false=right side
+    float sceneryOffset = 0;         // -0.8..0.8, varies the distance from the road edge
+
+    void project(int camX, int camY, int camZ) {
+        scale = CAM_D / (z - camZ);
+        X = (1 + scale * (x - camX)) * WIDTH / 2;
+        Y = (1 - scale * (y - camY)) * HEIGHT / 2;
+        W = scale * ROAD_W * WIDTH / 2;
+    }
+
+    // Screen bounds of the opponent car, or an empty rect when there is none or it is culled
+    sf::FloatRect opponentRect(int playerZ, sf::Vector2u texSize) const {
+        // Early outs
+        if (!hasOpponent) return sf::FloatRect();
+
+        float originalWidth = float(texSize.x);
+        float originalHeight = float(texSize.y);
+        if (originalWidth <= 0 || originalHeight <= 0) return sf::FloatRect();
+
+        // Distance in world units from the player to this segment
+        float dz = z - playerZ;
+        if (dz <= 0) return sf::FloatRect(); // behind or at player
+
+        // --- WIDTH / SCALE DETERMINATION ---
+        // Use the projected road half-width (W) to get a lane pixel width. This automatically
+        // encodes perspective (far segments have smaller W, near segments have larger W).
+        float laneWidth = (W * 2.0f) / NUM_LANES; // pixels
+
+        // Base fraction of the lane that a car occupies (tweakable)
+        const float LANE_CAR_FRACTION = 0.55f; // 55% of lane width by default
+        float destW = laneWidth * LANE_CAR_FRACTION;
+
+        // Add a small "close-up" boost so cars feel noticeably bigger when they're very near
+        const float CLOSE_BOOST_RANGE = SEG_LEN * 6; // within ~6 segments we start boosting size
+        if (dz < CLOSE_BOOST_RANGE) {
+            float t = (CLOSE_BOOST_RANGE - dz) / CLOSE_BOOST_RANGE; // 0..1
+            const float CLOSE_MAX_BOOST = 0.45f; // up to +45% size
+            destW *= (1.0f + t * CLOSE_MAX_BOOST);
+        }
+
+        // Keep sizes within reasonable screen bounds
+        destW = std::max(8.0f, std::min(destW, WIDTH * 0.9f));
+
+        // Preserve aspect ratio
+        float destH = destW * (originalHeight / originalWidth);
+        destH = std::max(6.0f, std::min(destH, HEIGHT * 0.9f));
+
+        // --- POSITIONING (use projected X, Y and lane offsets) ---
+        float laneStart = -W + laneWidth * opponentLane;
+        float laneCenter = laneStart + laneWidth * 0.5f + opponentOffset * laneWidth * 0.25f; // small lateral offset
+
+        float carX = X + laneCenter - destW * 0.5f;
+        // Place the bottom of the sprite exactly on the road (Y is road surface in projection)
+        float carY = Y - destH;
+
+        // Cull if completely off-screen
+        if (carY > HEIGHT + 200 || carY + destH < -200 || carX + destW < -200 || carX > WIDTH + 200) {
+            return sf::FloatRect();
+        }
+        return sf::FloatRect(carX, carY, destW, destH);
+    }
+
+    // Lay out the opponent car (and its shadow); returns the car's screen bounds or an empty rect
+    sf::FloatRect layoutOpponent(std::vector<Billboard>& out, int playerZ, sf::Vector2u texSize) const {
+        sf::FloatRect carRect = opponentRect(playerZ, texSize);
+        if (carRect.width <= 0) return carRect;
+
+        float dz = z - playerZ;
+        float destW = carRect.width;
+        float carX = carRect.left;
+
+        // --- SHADOW ---
+        if (destW > 8.0f) {
+            float shadowW = destW * 0.78f;
+            float shadowH = std::max(3.0f, destW * 0.06f);
+            // Center shadow under the car, slightly above the projected road to simulate contact
+            Billboard shadow;
+            shadow.kind = SHADOW_BILLBOARD;
+            shadow.rect = sf::FloatRect(carX + destW * 0.5f - shadowW * 0.5f, Y - shadowH + 4.0f, shadowW, shadowH);
+
+            // Shadow alpha stronger when closer
+            float alpha = 60.0f + (1.0f - std::min(dz / (SEG_LEN * 12.0f), 1.0f)) * 140.0f; // between ~60 and ~200
+            if (alpha > 200.0f) alpha = 200.0f;
+            shadow.color = sf::Color(0, 0, 0, static_cast<sf::Uint8>(alpha));
+            out.push_back(shadow);
+        }
+
+        // --- CAR ---
+        Billboard car;
+        car.kind = OPPONENT_BILLBOARD;
+        car.texture = opponentType;
+        car.rect = carRect;
+        out.push_back(car);
+
+        return car.rect;
+    }
+
+    void layoutScenery(std::vector<Billboard>& out, int playerZ, sf::Vector2u texSize) const {
+        if (!hasScenery || texSize.x == 0) return;
+
+        // Calculate distance-based scale - MAXIMUM VISIBILITY RANGE
+        float distance = std::abs(z - playerZ);
+
+        // MAXIMUM: Objects visible from VERY far away for ultra-smooth appearance
+        float scale;
+
+        if (distance > SEG_LEN * 120) {
+            return; // Too far to see - GREATLY EXTENDED from 80 to 120 segments
+        }
+        else if (distance > SEG_LEN * 100) {
+            // Far horizon: barely visible dots (0.02 to 0.04)
+            float t = (SEG_LEN * 120 - distance) / (SEG_LEN * 20);
+            scale = 0.02f + t * 0.02f;
+        }
+        else if (distance > SEG_LEN * 80) {
+            // Horizon: tiny but visible dots (0.04 to 0.06)
+            float t = (SEG_LEN * 100 - distance) / (SEG_LEN * 20);
+            scale = 0.04f + t * 0.02f;
+        }
+        else if (distance > SEG_LEN * 60) {
+            // Very very far: small specks (0.06 to 0.09)
+            float t = (SEG_LEN * 80 - distance) / (SEG_LEN * 20);
+            scale = 0.06f + t * 0.03f;
+        }
+        else if (distance > SEG_LEN * 45) {
+            // Very far: becoming noticeable (0.09 to 0.14)
+            float t = (SEG_LEN * 60 - distance) / (SEG_LEN * 15);
+            scale = 0.09f + t * 0.05f;
+        }
+        else if (distance > SEG_LEN * 30) {
+            // Far: clearly visible (0.14 to 0.22)
+            float t = (SEG_LEN * 45 - distance) / (SEG_LEN * 15);
+            scale = 0.14f + t * 0.08f;
+        }
+        else if (distance > SEG_LEN * 20) {
+            // Medium-far: good size (0.22 to 0.35)
+            float t = (SEG_LEN * 30 - distance) / (SEG_LEN * 10);
+            scale = 0.22f + t * 0.13f;
+        }
+        else if (distance > SEG_LEN * 12) {
+            // Medium: prominent (0.35 to 0.55)
+            float t = (SEG_LEN * 20 - distance) / (SEG_LEN * 8);
+            scale = 0.35f + t * 0.2f;
+        }
+        else if (distance > SEG_LEN * 6) {
+            // Close: large and impressive (0.55 to 0.85)
+            float t = (SEG_LEN * 12 - distance) / (SEG_LEN * 6);
+            scale = 0.55f + t * 0.3f;
+        }
+        else if (distance > SEG_LEN * 3) {
+            // Very close: dramatic size (0.85 to 1.3)
+            float t = (SEG_LEN * 6 - distance) / (SEG_LEN * 3);
+            scale = 0.85f + t * 0.45f;
+        }
+        else if (distance > SEG_LEN * 1) {
+            // Extremely close: maximum size (1.3 to 1.8)
+            float t = (SEG_LEN * 3 - distance) / (SEG_LEN * 2);
+            scale = 1.3f + t * 0.5f;
+        }
+        else {
+            // Right next to car: full size but reasonable (1.8 to 2.2)
+            float t = (SEG_LEN * 1 - distance) / (SEG_LEN * 1);
+            scale = 1.8f + t * 0.4f;
+        }
+
+        // Make grass smaller than other scenery
+        if (sceneryType == 3) { // grass
+            scale *= 0.6f; // Make grass 60% of normal size
+        }
+
+        // Calculate scaled size
+        float destW = float(texSize.x) * scale;
+        float destH = float(texSize.y) * scale;
+
+        // Position based on scenery type - different positioning for natural look
+        float sideOffset;
+        if (sceneryType == 2) { // House - always on right side
+            sideOffset = W + destW * 0.5f + 200; // Right side only
+        }
+        else if (sceneryType == 3) { // Grass - always on left side
+            float grassDistance = 40 + (std::abs(sceneryOffset) * 60); // 40-100 units from road edge
+            sideOffset = -(W + destW * 0.5f + grassDistance); // Left side only
+        }
+        else { // Palm trees - vary distance from road for natural randomness
+            float treeDistance = 60 + (std::abs(sceneryOffset) * 80); // 60-140 units from road edge
+            sideOffset = sceneryOnLeft ?
+                -(W + destW * 0.5f + treeDistance) :
+                (W + destW * 0.5f + treeDistance);
+        }
+
+        float sceneryX = X + sideOffset;
+        float sceneryY = Y - destH; // Sit on ground level
+
+        // ULTRA generous screen bounds to catch very distant objects
+        if (sceneryY > HEIGHT + 300 || sceneryY + destH < -150 ||
+            sceneryX + destW < -300 || sceneryX > WIDTH + 300 || destW < 1.5f) { // Very small minimum for maximum distance
+            return;
+        }
+
+        Billboard b;
+        b.kind = SCENERY_BILLBOARD;
+        b.texture = sceneryType;
+        b.rect = sf::FloatRect(sceneryX, sceneryY, destW, destH);
+        out.push_back(b);
+    }
+};
+
+// Random source for opponents spawned during a race
+struct TrackRandom {
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist_lane{ 0, NUM_LANES - 1 };
+    std::uniform_int_distribution<int> dist_car_type{ 0, 1 };
+    std::uniform_int_distribution<int> dist_spawn{ 0, 100 };
+    std::uniform_real_distribution<float> dist_offset{ -0.8f, 0.8f };
+
+    explicit TrackRandom(unsigned seed) : rng(seed) {}
+};
+
+// Curves and hills of segment i; resets everything else on the line
+inline void buildRoadSegment(Line& line, int i) {
+    line = Line();
+    line.z = float(i * SEG_LEN);
+
+    // Reduced curves to make road more natural
+    if (i > 300 && i < 700) line.curve = 0.2f;  // Reduced from 0.5f
+    if (i > 1100) line.curve = -0.3f;           // Reduced from -0.7f
+
+    // Reduced hills for smoother road
+    if (i > 750 && i < 1000) {
+        line.y = std::sin((i - 750) * 0.02f) * 800;  // Reduced from 0.025f * 1500
+    }
+}
+
+// Highest road point in each segment's view window [i, i + window), wrapping around the
+// track. Only depends on the road shape, which never changes.
+inline void buildViewMaxY(const std::vector<Line>& lines, int window, std::vector<float>& out) {
+    const int N = int(lines.size());
+    out.assign(N, 0.f);
+    for (int i = 0; i < N; i++) {
+        float highest = lines[i].y;
+        for (int k = 1; k < window; k++) highest = std::max(highest, lines[(i + k) % N].y);
+        out[i] = highest;
+    }
+}
+
+// Horizon test after projecting a segment with `scale`: true when nothing further out
+// can reach the center of the pixel row above the clip line `maxy`, so no pixel changes. `rise` is how far the highest road
+// point still ahead sits above the camera (negative when the camera is above all of it);
+// further segments have smaller scales, down to `farScale` at the end of the view.
+inline bool pastHorizon(float scale, float farScale, float rise, int maxy) {
+    // Above the camera, the nearest of them can climb highest; below it, the furthest
+    float s = rise > 0 ? scale : farScale;
+    return HEIGHT / 2 * (1 - s * rise) >= maxy - 0.5f;
+}
+
+// Initialize road with curves and hills
+inline void buildRoad(std::vector<Line>& lines, int N) {
+    lines.resize(N);
+    for (int i = 0; i < N; i++) buildRoadSegment(lines[i], i);
+}
+
+inline void placeOpponent(Line& line, TrackRandom& r) {
+    line.hasOpponent = true;
+    line.opponentLane = r.dist_lane(r.rng);
+    line.opponentOffset = r.dist_offset(r.rng);
+    line.opponentType = r.dist_car_type(r.rng);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "GameOptions.h"
+#include "Track.h"
+#include "TrackGenerator.h"
+#include "WorkerPool.h"
+
+// Fingerprint of everything the generator decides about a track
+inline std::uint64_t trackChecksum(const std::vector<Line>& lines) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](std::uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+    auto bits = [](float f) { std::uint32_t u; std::memcpy(&u, &f, 4); return std::uint64_t(u); };
+    for (const Line& l : lines) {
+        mix(bits(l.y));
+        mix(bits(l.curve));
+        if (l.hasOpponent) mix(std::uint64_t(l.opponentLane) << 8 | std::uint64_t(l.opponentType) << 16 | bits(l.opponentOffset) << 24);
+        if (l.hasScenery) mix(std::uint64_t(l.sceneryType) << 8 | std::uint64_t(l.sceneryOnLeft) << 16 | bits(l.sceneryOffset) << 24);
+    }
+    return h;
+}
+
+// --bench-track=SEGMENTS: generate a track that long on one thread and on --threads
+// threads, report segments per second and check every thread count builds the same track.
+// With --stress the track is fully populated.
+inline int runTrackBenchmark(const GameOptions& options) {
+    const int segments = options.benchTrackSegments;
+    const TrackKey key{ options.seed != 0 ? options.seed : 1, 0, options.stressScene ? &STRESS_SPAWNS : &TRACK_SPAWNS };
+    std::vector<Line> lines;
+    lines.reserve(segments);
+
+    int poolThreads = options.threads > 0 ? options.threads : int(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts = { 1, poolThreads, 3, 7 };
+    std::uint64_t expected = 0;
+    bool identical = true;
+
+    std::cout << "Track generation: " << segments << " segments, " << sizeof(Line) << " bytes per segment" << std::endl;
+    for (std::size_t i = 0; i < threadCounts.size(); i++) {
+        int threads = threadCounts[i];
+        if (i > 0 && std::find(threadCounts.begin(), threadCounts.begin() + i, threads) != threadCounts.begin() + i) continue;
+        WorkerPool pool(threads);
+
+        // Best of three, so page faults on the first pass don't count
+        double bestSeconds = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            generateTrack(lines, segments, key, true, &pool);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (run == 0 || seconds < bestSeconds) bestSeconds = seconds;
+        }
+
+        std::uint64_t checksum = trackChecksum(lines);
+        if (i == 0) expected = checksum;
+        identical = identical && checksum == expected;
+
+        int opponents = 0, scenery = 0;
+        for (const Line& l : lines) {
+            opponents += l.hasOpponent;
+            scenery += l.hasScenery;
+        }
+        std::cout << "  " << threads << (threads == 1 ? " thread:  " : " threads: ") << bestSeconds * 1000 << " ms, "
+            << (bestSeconds > 0 ? segments / bestSeconds : 0) << " segments/s, " << opponents << " opponents, "
+            << scenery << " scenery, checksum " << std::hex << checksum << std::dec << std::endl;
+    }
+
+    std::cout << (identical ? "Same track for every thread count" : "Thread counts built DIFFERENT tracks") << std::endl;
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "GameConfig.h"
+#include "Philox.h"
+#include "Track.h"
+#include "WorkerPool.h"
+
+enum SpawnKind { OPPONENT_SPAWN, SCENERY_SPAWN };
+enum ScenerySide { EITHER_SIDE, LEFT_SIDE, RIGHT_SIDE };
+
+// One weighted entry of a scenery spawn table
+struct SceneryChoice {
+    int weight;
+    int sceneryType;  // 0=palm1, 1=palm2, 2=house, 3=grass
+    ScenerySide side;
+};
+
+// A pass of objects along the track. Candidates sit on a jittered grid: cell k starts
+// at firstSegment + k * spacing and its candidate lands up to `jitter` segments into
+// it, so consecutive candidates are spacing - jitter .. spacing + jitter apart.
+struct SpawnRule {
+    SpawnKind kind;
+    int firstSegment;
+    int spacing;
+    int jitter;
+    int chancePct;          // chance that a candidate is placed
+    int maxCount;           // only the first this many cells (0 = no limit)
+    bool onlyIfEmpty;       // scenery: skip segments an earlier pass already used
+    const SceneryChoice* choices;
+    int choiceCount;
+};
+
+const SceneryChoice ROADSIDE_SCENERY[] = {
+    { 4, 0, EITHER_SIDE },  // Palm tree 1 (40% chance)
+    { 3, 1, EITHER_SIDE },  // Palm tree 2 (30% chance)
+    { 1, 2, RIGHT_SIDE },   // House (10% chance), always right side
+    { 2, 3, LEFT_SIDE },    // Grass (20% chance), always left side
+};
+
+const SceneryChoice ROADSIDE_PALMS[] = {
+    { 1, 0, EITHER_SIDE },
+    { 1, 1, EITHER_SIDE },
+};
+
+// Track setup, in order. Spacing matches the old serial passes (their gaps were drawn
+// from 0..100, so 150-250, 20-60 and 35-59 segments).
+const SpawnRule TRACK_SPAWN_RULES[] = {
+    // Very few cars initially, starting late and widely spaced; more spawn during the race
+    { OPPONENT_SPAWN, 400, 200, 50, 100, 8, false, nullptr, 0 },
+    // Frequent trees, houses on the right and grass on the left
+    { SCENERY_SPAWN, 100, 40, 20, 75, 0, false, ROADSIDE_SCENERY, 4 },
+    // Another layer of palm trees for a lush roadside
+    { SCENERY_SPAWN, 50, 47, 12, 40, 0, true, ROADSIDE_PALMS, 2 },
+};
+
+// --stress: every segment that can hold an opponent or a roadside object gets one,
+// leaving only the start clear. A Line has room for one of each, so this is the most
+// the renderer can ever be handed.
+const SpawnRule STRESS_SPAWN_RULES[] = {
+    { OPPONENT_SPAWN, 20, 1, 0, 100, 0, false, nullptr, 0 },
+    { SCENERY_SPAWN, 0, 1, 0, 100, 0, false, ROADSIDE_SCENERY, 4 },
+};
+
+// A list of spawn rules, applied in order
+struct SpawnTable {
+    const SpawnRule* rules;
+    int count;
+};
+
+const SpawnTable TRACK_SPAWNS = { TRACK_SPAWN_RULES, int(sizeof(TRACK_SPAWN_RULES) / sizeof(TRACK_SPAWN_RULES[0])) };
+const SpawnTable STRESS_SPAWNS = { STRESS_SPAWN_RULES, int(sizeof(STRESS_SPAWN_RULES) / sizeof(STRESS_SPAWN_RULES[0])) };
+
+// Which track to build: the seed, how many times the race has been restarted on it,
+// and what populates it
+struct TrackKey {
+    unsigned seed = 0;
+    unsigned generation = 0;
+    const SpawnTable* spawns = &TRACK_SPAWNS;
+};
+
+// The numbers for one grid cell of one rule. Every decision about a candidate is drawn
+// from here, so a cell comes out the same whichever chunk or thread builds it.
+inline CounterRandom cellRandom(const TrackKey& key, int rule, int cell) {
+    return CounterRandom(key.seed, 0x7261636Bu, std::uint32_t(cell), std::uint32_t(rule), key.generation);
+}
+
+// Call fn(segment, random) for every candidate of `rule` that lands in [begin, end) and
+// wins its chance roll; `random` continues with the cell's remaining draws
+template <typename Fn>
+inline void forEachSpawn(const TrackKey& key, int ruleIndex, int begin, int end, Fn fn) {
+    const SpawnRule& rule = key.spawns->rules[ruleIndex];
+    int firstCell = std::max(0, (begin - rule.firstSegment - rule.jitter) / rule.spacing);
+    for (int cell = firstCell; rule.maxCount == 0 || cell < rule.maxCount; cell++) {
+        std::int64_t cellStart = rule.firstSegment + std::int64_t(cell) * rule.spacing;
+        if (cellStart >= end) break;
+
+        CounterRandom random = cellRandom(key, ruleIndex, cell);
+        int segment = int(cellStart) + random.uniform(rule.jitter + 1);
+        if (segment < begin || segment >= end) continue;
+        if (random.uniform(100) >= rule.chancePct) continue;
+        fn(segment, random);
+    }
+}
+
+inline void placeOpponent(Line& line, CounterRandom& r) {
+    line.hasOpponent = true;
+    line.opponentLane = r.uniform(NUM_LANES);
+    line.opponentOffset = r.uniform(-0.8f, 0.8f);
+    line.opponentType = r.uniform(2);
+}
+
+inline void placeScenery(Line& line, const SpawnRule& rule, CounterRandom& r) {
+    int total = 0;
+    for (int i = 0; i < rule.choiceCount; i++) total += rule.choices[i].weight;
+    int pick = r.uniform(total);
+    const SceneryChoice* choice = rule.choices;
+    while (pick >= choice->weight) {
+        pick -= choice->weight;
+        choice++;
+    }
+
+    line.hasScenery = true;
+    line.sceneryType = choice->sceneryType;
+    bool leftRoll = r.uniform(2) == 0;
+    line.sceneryOnLeft = choice->side == EITHER_SIDE ? leftRoll : choice->side == LEFT_SIDE;
+    line.sceneryOffset = r.uniform(-0.8f, 0.8f);
+}
+
+// Build segments [begin, end) of a track: road shape, then every spawn rule in order
+inline void generateTrackChunk(std::vector<Line>& lines, int begin, int end, const TrackKey& key, bool withScenery) {
+    for (int i = begin; i < end; i++) buildRoadSegment(lines[i], i);
+
+    for (int r = 0; r < key.spawns->count; r++) {
+        const SpawnRule& rule = key.spawns->rules[r];
+        if (rule.kind == SCENERY_SPAWN && !withScenery) continue;
+        forEachSpawn(key, r, begin, end, [&](int segment, CounterRandom& random) {
+            Line& line = lines[segment];
+            if (rule.kind == OPPONENT_SPAWN) placeOpponent(line, random);
+            else if (!rule.onlyIfEmpty || !line.hasScenery) placeScenery(line, rule, random);
+        });
+    }
+}
+
+// Build a whole track, split over `pool` when given. The result only depends on the key.
+inline void generateTrack(std::vector<Line>& lines, int segments, const TrackKey& key, bool withScenery, WorkerPool* pool = nullptr) {
+    lines.resize(segments);
+    if (!pool) {
+        generateTrackChunk(lines, 0, segments, key, withScenery);
+        return;
+    }
+    pool->parallelFor(segments, [&](int begin, int end, int) {
+        generateTrackChunk(lines, begin, end, key, withScenery);
+    });
+}
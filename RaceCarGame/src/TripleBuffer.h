@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer for one writer thread and one reader thread.
+// The writer always has a private slot to fill, the reader always has a private slot to read,
+// and the third slot in the middle holds the newest published value.
+template <typename T>
+class TripleBuffer {
+public:
+    // Only call before either thread starts using the buffer
+    template <typename Fn>
+    void forEachSlot(Fn fn) {
+        for (T& slot : slots) fn(slot);
+    }
+
+    // Writer side
+    T& writeBuffer() { return slots[back]; }
+
+    void publish() {
+        std::uint8_t prev = middle.exchange(std::uint8_t(back | FRESH_BIT), std::memory_order_acq_rel);
+        back = prev & INDEX_MASK;
+        published.fetch_add(1, std::memory_order_relaxed);
+        if (prev & FRESH_BIT) dropped.fetch_add(1, std::memory_order_relaxed); // overwritten before it was read
+    }
+
+    // Reader side; returns false (and keeps the current slot) when nothing new was published
+    bool acquire() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH_BIT)) {
+            repeated.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::uint8_t prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & INDEX_MASK;
+        return true;
+    }
+
+    const T& readBuffer() const { return slots[front]; }
+
+    // Stats
+    std::uint64_t publishedCount() const { return published.load(std::memory_order_relaxed); }
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    std::uint64_t repeatedCount() const { return repeated.load(std::memory_order_relaxed); }
+
+private:
+    static const std::uint8_t INDEX_MASK = 0x3;
+    static const std::uint8_t FRESH_BIT = 0x4;
+
+    T slots[3];
+    std::uint8_t back = 0;                 // owned by the writer
+    std::uint8_t front = 2;                // owned by the reader
+    std::atomic<std::uint8_t> middle{ 1 }; // shared: slot index plus FRESH_BIT
+
+    std::atomic<std::uint64_t> published{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::atomic<std::uint64_t> repeated{ 0 };
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads for splitting one job over contiguous ranges. The calling
+// thread takes the first range itself. Which thread gets which range depends only on
+// the item and thread counts, and a job allocates nothing.
+class WorkerPool {
+public:
+    // `threadCount` includes the calling thread; 0 = one per hardware thread
+    explicit WorkerPool(int threadCount) {
+        if (threadCount <= 0) threadCount = int(std::max(1u, std::thread::hardware_concurrency()));
+        count = threadCount;
+        for (int i = 1; i < count; i++) workers.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return count; }
+
+    // Split [0, items) into size() ranges and call fn(begin, end, worker) for each
+    // non-empty one; returns once all of them are done
+    template <typename Fn>
+    void parallelFor(int items, const Fn& fn) {
+        auto task = [&](int worker) {
+            int begin = int(std::int64_t(items) * worker / count);
+            int end = int(std::int64_t(items) * (worker + 1) / count);
+            if (begin < end) fn(begin, end, worker);
+        };
+        if (count == 1) {
+            task(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = [](void* context, int worker) { (*static_cast<decltype(task)*>(context))(worker); };
+            jobContext = &task;
+            pending = count - 1;
+            generation++;
+        }
+        wake.notify_all();
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    void workerLoop(int worker) {
+        unsigned seen = 0;
+        for (;;) {
+            void (*run)(void*, int);
+            void* context;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                run = job;
+                context = jobContext;
+            }
+            run(context, worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) finished.notify_one();
+        }
+    }
+
+    int count = 1;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    void (*job)(void*, int) = nullptr;
+    void* jobContext = nullptr;
+    unsigned generation = 0;
+    int pending = 0;
+    bool stopping = false;
+};
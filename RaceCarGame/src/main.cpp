@@ -2,259 +2,46 @@
 #include <SFML/Audio.hpp>
 #include <iostream>
 #include <vector>
-#include <sstream>
+#include <memory>
 #include <cstdlib>
 #include <ctime>
-#include <random>
+#include <cstdio>
+#include <cassert>
+#include "GameConfig.h"
+#include "AllocationCounter.h"
+#include "BatchBenchmark.h"
+#include "BillboardTextures.h"
+#include "EngineVoices.h"
+#include "FrameArena.h"
+#include "FramePacer.h"
+#include "FrameRenderer.h"
+#include "FrameSnapshot.h"
+#include "GameOptions.h"
+#include "GoldenFrames.h"
+#include "Headless.h"
+#include "Hud.h"
+#include "ImpostorLayer.h"
+#include "InputLog.h"
+#include "MemoryReport.h"
+#include "ProfilerOverlay.h"
+#include "QualityGovernor.h"
+#include "RedrawScheduler.h"
+#include "SamplingBenchmark.h"
+#include "Simulation.h"
+#include "SfmlBackend.h"
+#include "SimulationThread.h"
+#include "SoftwareRenderer.h"
+#include "SoundPool.h"
+#include "TextUtil.h"
+#include "TiledPanorama.h"
+#include "Timing.h"
+#include "TrackBenchmark.h"
 
 using namespace sf;
 using namespace std;
 
-// Window dimensions
-const int WIDTH = 1024;
-const int HEIGHT = 768;
-
-// Road parameters
-const int ROAD_W = 2500;  // Increased road width (was 2000)
-const int SEG_LEN = 200;   // Segment length
-const float CAM_D = 0.84f;  // Camera depth
-
-const int NUM_LANES = 3;
-
-// Game states
-enum GameState { MENU, CAR_SELECTION, PLAYING, GAME_OVER_PROMPT };
-
-// Car types
-enum CarType { NORMAL_CAR, POLICE_CAR };
-
-// Draw one segment of road as a quad
-void drawQuad(RenderWindow& w, Color c, int x1, int y1, int w1, int x2, int y2, int w2) {
-    ConvexShape shape(4);
-    shape.setFillColor(c);
-    shape.setPoint(0, Vector2f(float(x1 - w1), float(y1)));
-    shape.setPoint(1, Vector2f(float(x2 - w2), float(y2)));
-    shape.setPoint(2, Vector2f(float(x2 + w2), float(y2)));
-    shape.setPoint(3, Vector2f(float(x1 + w1), float(y1)));
-    w.draw(shape);
-}
-
-// One line/segment of the road
-struct Line {
-    float x = 0, y = 0, z = 0;       // 3D world coordinates
-    float X = 0, Y = 0, W = 0;       // screen coordinates
-    float clip = 0, scale = 0;
-    float curve = 0;                 // curve value for this segment
-    Sprite opCar;                    // opponent car sprite
-    bool hasOpponent = false;
-    int opponentLane = 1;            // Which lane (0, 1, 2) the opponent is in
-    float opponentOffset = 0;        // Offset within the lane for variety
-
-    // Scenery objects
-    Sprite scenerySprite;
-    bool hasScenery = false;
-    int sceneryType = 0;             // 0=palm1, 1=palm2, 2=house, 3=grass
-    bool sceneryOnLeft = true;       // true=left side, false=right side
-
-    void project(int camX, int camY, int camZ) {
-        scale = CAM_D / (z - camZ);
-        X = (1 + scale * (x - camX)) * WIDTH / 2;
-        Y = (1 - scale * (y - camY)) * HEIGHT / 2;
-        W = scale * ROAD_W * WIDTH / 2;
-    }
-
-    FloatRect drawOpponent(RenderWindow& win, int playerZ) {
-        // Early outs
-        if (!hasOpponent || !opCar.getTexture()) return FloatRect();
-
-        Sprite s = opCar;
-        IntRect rt = s.getTextureRect();
-        float originalWidth = (rt.width > 0) ? float(rt.width) : float(s.getTexture()->getSize().x);
-        float originalHeight = (rt.height > 0) ? float(rt.height) : float(s.getTexture()->getSize().y);
-        if (originalWidth <= 0 || originalHeight <= 0) return FloatRect();
-
-        // Distance in world units from the player to this segment
-        float dz = z - playerZ;
-        if (dz <= 0) return FloatRect(); // behind or at player
-
-        // --- WIDTH / SCALE DETERMINATION ---
-        // Use the projected road half-width (W) to get a lane pixel width. This automatically
-        // encodes perspective (far segments have smaller W, near segments have larger W).
-        float laneWidth = (W * 2.0f) / NUM_LANES; // pixels
-
-        // Base fraction of the lane that a car occupies (tweakable)
-        const float LANE_CAR_FRACTION = 0.55f; // 55% of lane width by default
-        float destW = laneWidth * LANE_CAR_FRACTION;
-
-        // Add a small "close-up" boost so cars feel noticeably bigger when they're very near
-        const float CLOSE_BOOST_RANGE = SEG_LEN * 6; // within ~6 segments we start boosting size
-        if (dz < CLOSE_BOOST_RANGE) {
-            float t = (CLOSE_BOOST_RANGE - dz) / CLOSE_BOOST_RANGE; // 0..1
-            const float CLOSE_MAX_BOOST = 0.45f; // up to +45% size
-            destW *= (1.0f + t * CLOSE_MAX_BOOST);
-        }
-
-        // Keep sizes within reasonable screen bounds
-        destW = max(8.0f, min(destW, WIDTH * 0.9f));
-
-        // Preserve aspect ratio
-        float destH = destW * (originalHeight / originalWidth);
-        destH = max(6.0f, min(destH, HEIGHT * 0.9f));
-
-        // --- POSITIONING (use projected X, Y and lane offsets) ---
-        float laneStart = -W + laneWidth * opponentLane;
-        float laneCenter = laneStart + laneWidth * 0.5f + opponentOffset * laneWidth * 0.25f; // small lateral offset
-
-        float carX = X + laneCenter - destW * 0.5f;
-        // Place the bottom of the sprite exactly on the road (Y is road surface in projection)
-        float carY = Y - destH;
-
-        // Cull if completely off-screen
-        if (carY > HEIGHT + 200 || carY + destH < -200 || carX + destW < -200 || carX > WIDTH + 200) {
-            return FloatRect();
-        }
-
-        // --- SHADOW ---
-        if (destW > 8.0f) {
-            float shadowW = destW * 0.78f;
-            float shadowH = max(3.0f, destW * 0.06f);
-            RectangleShape shadow(Vector2f(shadowW, shadowH));
-            // Center shadow under the car, slightly above the projected road to simulate contact
-            shadow.setOrigin(shadowW * 0.5f, shadowH * 0.5f);
-            shadow.setPosition(carX + destW * 0.5f, Y - shadowH * 0.5f + 4.0f);
-
-            // Shadow alpha stronger when closer
-            float alpha = 60.0f + (1.0f - min(dz / (SEG_LEN * 12.0f), 1.0f)) * 140.0f; // between ~60 and ~200
-            if (alpha > 200.0f) alpha = 200.0f;
-            shadow.setFillColor(Color(0, 0, 0, static_cast<Uint8>(alpha)));
-            win.draw(shadow);
-        }
-
-        // --- DRAW CAR ---
-        s.setTextureRect(IntRect(0, 0, int(originalWidth), int(originalHeight)));
-        s.setScale(destW / originalWidth, destH / originalHeight);
-        s.setPosition(carX, carY);
-        win.draw(s);
-
-        return FloatRect(carX, carY, destW, destH);
-    }
-
-    void drawScenery(RenderWindow& win, int playerZ) {
-        if (!hasScenery || !scenerySprite.getTexture()) return;
-
-        // Calculate distance-based scale - MAXIMUM VISIBILITY RANGE
-        float distance = abs(z - playerZ);
-
-        // MAXIMUM: Objects visible from VERY far away for ultra-smooth appearance
-        float scale;
-
-        if (distance > SEG_LEN * 120) {
-            return; // Too far to see - GREATLY EXTENDED from 80 to 120 segments
-        }
-        else if (distance > SEG_LEN * 100) {
-            // Far horizon: barely visible dots (0.02 to 0.04)
-            float t = (SEG_LEN * 120 - distance) / (SEG_LEN * 20);
-            scale = 0.02f + t * 0.02f;
-        }
-        else if (distance > SEG_LEN * 80) {
-            // Horizon: tiny but visible dots (0.04 to 0.06)
-            float t = (SEG_LEN * 100 - distance) / (SEG_LEN * 20);
-            scale = 0.04f + t * 0.02f;
-        }
-        else if (distance > SEG_LEN * 60) {
-            // Very very far: small specks (0.06 to 0.09)
-            float t = (SEG_LEN * 80 - distance) / (SEG_LEN * 20);
-            scale = 0.06f + t * 0.03f;
-        }
-        else if (distance > SEG_LEN * 45) {
-            // Very far: becoming noticeable (0.09 to 0.14)
-            float t = (SEG_LEN * 60 - distance) / (SEG_LEN * 15);
-            scale = 0.09f + t * 0.05f;
-        }
-        else if (distance > SEG_LEN * 30) {
-            // Far: clearly visible (0.14 to 0.22)
-            float t = (SEG_LEN * 45 - distance) / (SEG_LEN * 15);
-            scale = 0.14f + t * 0.08f;
-        }
-        else if (distance > SEG_LEN * 20) {
-            // Medium-far: good size (0.22 to 0.35)
-            float t = (SEG_LEN * 30 - distance) / (SEG_LEN * 10);
-            scale = 0.22f + t * 0.13f;
-        }
-        else if (distance > SEG_LEN * 12) {
-            // Medium: prominent (0.35 to 0.55)
-            float t = (SEG_LEN * 20 - distance) / (SEG_LEN * 8);
-            scale = 0.35f + t * 0.2f;
-        }
-        else if (distance > SEG_LEN * 6) {
-            // Close: large and impressive (0.55 to 0.85)
-            float t = (SEG_LEN * 12 - distance) / (SEG_LEN * 6);
-            scale = 0.55f + t * 0.3f;
-        }
-        else if (distance > SEG_LEN * 3) {
-            // Very close: dramatic size (0.85 to 1.3)
-            float t = (SEG_LEN * 6 - distance) / (SEG_LEN * 3);
-            scale = 0.85f + t * 0.45f;
-        }
-        else if (distance > SEG_LEN * 1) {
-            // Extremely close: maximum size (1.3 to 1.8)
-            float t = (SEG_LEN * 3 - distance) / (SEG_LEN * 2);
-            scale = 1.3f + t * 0.5f;
-        }
-        else {
-            // Right next to car: full size but reasonable (1.8 to 2.2)
-            float t = (SEG_LEN * 1 - distance) / (SEG_LEN * 1);
-            scale = 1.8f + t * 0.4f;
-        }
-
-        // Make grass smaller than other scenery
-        if (sceneryType == 3) { // grass
-            scale *= 0.6f; // Make grass 60% of normal size
-        }
-
-        // Get original texture size
-        auto textureSize = scenerySprite.getTexture()->getSize();
-        float originalWidth = float(textureSize.x);
-        float originalHeight = float(textureSize.y);
-
-        // Calculate scaled size
-        float destW = originalWidth * scale;
-        float destH = originalHeight * scale;
-
-        // Position based on scenery type - different positioning for natural look
-        float sideOffset;
-        if (sceneryType == 2) { // House - always on right side
-            sideOffset = W + destW * 0.5f + 200; // Right side only
-        }
-        else if (sceneryType == 3) { // Grass - always on left side  
-            float grassDistance = 40 + (abs(opponentOffset) * 60); // 40-100 units from road edge
-            sideOffset = -(W + destW * 0.5f + grassDistance); // Left side only
-        }
-        else { // Palm trees - vary distance from road for natural randomness
-            float treeDistance = 60 + (abs(opponentOffset) * 80); // 60-140 units from road edge
-            sideOffset = sceneryOnLeft ?
-                -(W + destW * 0.5f + treeDistance) :
-                (W + destW * 0.5f + treeDistance);
-        }
-
-        float sceneryX = X + sideOffset;
-        float sceneryY = Y - destH; // Sit on ground level
-
-        // ULTRA generous screen bounds to catch very distant objects
-        if (sceneryY > HEIGHT + 300 || sceneryY + destH < -150 ||
-            sceneryX + destW < -300 || sceneryX > WIDTH + 300 || destW < 1.5f) { // Very small minimum for maximum distance
-            return;
-        }
-
-        // Set up and draw scenery
-        Sprite s = scenerySprite;
-        s.setScale(destW / originalWidth, destH / originalHeight);
-        s.setPosition(sceneryX, sceneryY);
-        win.draw(s);
-    }
-};
-
 // Display the main menu
-bool showMainMenu(RenderWindow& window) {
+bool showMainMenu(RenderWindow& window, ScreenUsage& usage) {
     Font font;
     if (!font.loadFromFile("fonts/OpenSans.ttf")) {
         // Try alternative path
@@ -289,9 +76,11 @@ bool showMainMenu(RenderWindow& window) {
     int selected = 0;
     Clock clock;
 
+    // Only the title moves, so redraw at its animation rate and sleep in between
+    RedrawScheduler redraw(usage, MENU_ANIMATION_FPS);
     while (window.isOpen()) {
         Event e;
-        while (window.pollEvent(e)) {
+        while (redraw.nextEvent(window, e)) {
             if (e.type == Event::Closed) return false;
             if (e.type == Event::KeyPressed) {
                 if (e.key.code == Keyboard::Up || e.key.code == Keyboard::W) {
@@ -325,7 +114,7 @@ bool showMainMenu(RenderWindow& window) {
 }
 
 // Display car selection screen
-CarType showCarSelection(RenderWindow& window) {
+CarType showCarSelection(RenderWindow& window, ScreenUsage& usage) {
     Font font;
     if (!font.loadFromFile("fonts/OpenSans.ttf")) {
         if (!font.loadFromFile("Fonts/OpenSans.ttf")) {
@@ -380,12 +169,19 @@ CarType showCarSelection(RenderWindow& window) {
     instruction.setFillColor(Color::Cyan);
     instruction.setPosition(WIDTH / 2 - instruction.getGlobalBounds().width / 2, HEIGHT - 100);
 
+    // Highlight for the selected car
+    RectangleShape border(Vector2f(220, 220));
+    border.setFillColor(Color::Transparent);
+    border.setOutlineColor(Color::Red);
+    border.setOutlineThickness(3);
+
     int selected = 0;
     Clock clock;
 
+    RedrawScheduler redraw(usage, MENU_ANIMATION_FPS);
     while (window.isOpen()) {
         Event e;
-        while (window.pollEvent(e)) {
+        while (redraw.nextEvent(window, e)) {
             if (e.type == Event::Closed) return NORMAL_CAR;
             if (e.type == Event::KeyPressed) {
                 if (e.key.code == Keyboard::Left || e.key.code == Keyboard::A) {
@@ -418,18 +214,10 @@ CarType showCarSelection(RenderWindow& window) {
 
         // Highlight selected car with a border
         if (selected == 0 && hasNormalCarImg) {
-            RectangleShape border(Vector2f(220, 220));
-            border.setFillColor(Color::Transparent);
-            border.setOutlineColor(Color::Red);
-            border.setOutlineThickness(3);
             border.setPosition(WIDTH / 4 - 110, HEIGHT / 2 - 60);
             window.draw(border);
         }
         else if (selected == 1 && hasPoliceCarImg) {
-            RectangleShape border(Vector2f(220, 220));
-            border.setFillColor(Color::Transparent);
-            border.setOutlineColor(Color::Red);
-            border.setOutlineThickness(3);
             border.setPosition(3 * WIDTH / 4 - 110, HEIGHT / 2 - 60);
             window.draw(border);
         }
@@ -440,37 +228,55 @@ CarType showCarSelection(RenderWindow& window) {
     return NORMAL_CAR;
 }
 
-int main() {
-    mt19937 rng((unsigned)time(nullptr));
-    uniform_int_distribution<int> dist_lane(0, NUM_LANES - 1);
-    uniform_int_distribution<int> dist_car_type(0, 1);
-    uniform_int_distribution<int> dist_spawn(0, 100);
-    uniform_real_distribution<float> dist_offset(-0.8f, 0.8f);
-    uniform_int_distribution<int> dist_scenery_type(0, 3);    // 4 scenery types now (0,1,2,3)
-    uniform_int_distribution<int> dist_side(0, 1);           // left or right side
-    uniform_int_distribution<int> dist_weighted_scenery(0, 9); // For weighted selection
+int main(int argc, char** argv) {
+    GameOptions options = parseOptions(argc, argv);
+    if (!options.error.empty()) {
+        cerr << "Error: " << options.error << endl;
+        return 1;
+    }
+    if (!options.goldenDir.empty()) return runGoldenFrames(options);
+    if (options.headlessTicks >= 0) return runHeadless(options);
+    if (options.benchSampling) return runSamplingBenchmark(options);
+    if (options.batchEnvs > 0) return runBatchBenchmark(options);
+    if (options.benchTrackSegments > 0) return runTrackBenchmark(options);
+
+    // A replay brings its own seed and input
+    InputLog replay;
+    if (!options.replayInputPath.empty() && !replay.load(options.replayInputPath)) {
+        cerr << "Error: could not read input recording " << options.replayInputPath << endl;
+        return 1;
+    }
 
     RenderWindow window(VideoMode(WIDTH, HEIGHT), "Car Race", Style::Default);
     window.setFramerateLimit(60);
 
-    if (!showMainMenu(window)) return 0;
+    // Waiting screens are drawn on demand; their cost is reported at exit
+    ScreenUsage menuUsage("Main menu"), carSelectionUsage("Car selection"), gameOverUsage("Game over screen");
+    if (!showMainMenu(window, menuUsage)) {
+        menuUsage.print(cout);
+        return 0;
+    }
 
     // Show car selection screen
-    CarType selectedCar = showCarSelection(window);
+    CarType selectedCar = showCarSelection(window, carSelectionUsage);
 
-    // Load sounds based on selected car
-    SoundBuffer bufEngine, bufOver, bufBoost;
-    Sound engine, sfxOver, sfxBoost;
+    // Load sounds based on selected car. The engine loop streams from disk; only the
+    // short effects are decoded up front.
+    Clock audioClock;
+    AudioStats audioStats;
+    Music engine;
+    SoundBuffer bufOver, bufBoost;
+    SoundPool effects;
 
     bool soundEnabled = true;
     if (selectedCar == NORMAL_CAR) {
-        if (!bufEngine.loadFromFile("sounds/sound.wav")) {
+        if (!engine.openFromFile("sounds/sound.wav")) {
             cerr << "Warning: sound.wav not found" << endl;
             soundEnabled = false;
         }
     }
     else {
-        if (!bufEngine.loadFromFile("sounds/policesound.wav")) {
+        if (!engine.openFromFile("sounds/policesound.wav")) {
             cerr << "Warning: policesound.wav not found" << endl;
             soundEnabled = false;
         }
@@ -484,12 +290,24 @@ int main() {
     }
 
     if (soundEnabled) {
-        engine.setBuffer(bufEngine);
         engine.setLoop(true);
         engine.play();
+        audioStats.addStream(engine);
+    }
+    effects.reserveVoices(bufBoost, 2);
+    effects.reserveVoices(bufOver, 1);
+    audioStats.addBuffer(bufOver);
+    audioStats.addBuffer(bufBoost);
+
+    // Opponents all drive the normal car, so they share a short loop of its engine
+    EngineVoices opponentEngines;
+    if (!opponentEngines.create("sounds/sound.wav")) {
+        cerr << "Warning: could not load the opponent engine loop" << endl;
     }
-    sfxOver.setBuffer(bufOver);
-    sfxBoost.setBuffer(bufBoost);
+    audioStats.bufferBytes += opponentEngines.loopBytes();
+    audioStats.decodeMs = audioClock.getElapsedTime().asMicroseconds() / 1000.f;
+    cout << "Audio: " << audioStats.decodeMs << " ms to load, " << audioStats.bufferBytes / 1024
+        << " KB decoded effects, " << audioStats.streamBytes / 1024 << " KB engine stream buffers" << endl;
 
     // Load fonts
     Font fontMain, fontScore;
@@ -512,17 +330,9 @@ int main() {
     tPrompt.setFillColor(Color::White);
     tPrompt.setPosition(WIDTH / 2 - tPrompt.getGlobalBounds().width / 2, HEIGHT / 2);
 
-    Text tScore("", fontScore, 25);
-    tScore.setFillColor(Color::Yellow);
-    tScore.setOutlineColor(Color::Black);
-    tScore.setOutlineThickness(2);
-    tScore.setPosition(10, 10);
-
-    Text tSpeed("", fontScore, 25);
-    tSpeed.setFillColor(Color::Cyan);
-    tSpeed.setOutlineColor(Color::Black);
-    tSpeed.setOutlineThickness(2);
-    tSpeed.setPosition(10, 40);
+    // Score, speed and booster display
+    Hud hud;
+    hud.create(fontScore);
 
     // Text for remaining boosts count
     Text tBoostCount("", fontScore, 30);
@@ -530,28 +340,19 @@ int main() {
     tBoostCount.setOutlineColor(Color::Black);
     tBoostCount.setOutlineThickness(2);
 
-    // Load background - PANORAMIC VERSION
-    Texture bgTex;
-    Sprite background;
-    if (bgTex.loadFromFile("images/bg4.png")) {
-        bgTex.setRepeated(false);  // CHANGED: disable repeating
-        background.setTexture(bgTex);
-        // Show more background (sky area) - increased from half to 60%
-        int skyHeight = HEIGHT * 0.6;  // Use upper 60% of screen for background
-        background.setTextureRect(IntRect(0, 0, WIDTH, skyHeight));
-        background.setPosition(0, 0);  // Position at top of screen
+    // Load background - PANORAMIC VERSION, tiled so only the part near the view is on the GPU
+    TiledPanorama background;
+    // Show more background (sky area) - increased from half to 60%
+    if (!background.load("images/bg4.png", int(HEIGHT * 0.6))) {  // Use upper 60% of screen for background
+        cerr << "Warning: bg4.png not found" << endl;
     }
 
     // Load booster UI textures
     Texture boosterIconTex, boosterTextTex;
-    Sprite boosterIcon, boosterText;
-    bool hasBoosterUI = false;
 
     if (boosterIconTex.loadFromFile("images/boostericon.png") &&
         boosterTextTex.loadFromFile("images/boostertext.png")) {
-        boosterIcon.setTexture(boosterIconTex);
-        boosterText.setTexture(boosterTextTex);
-        hasBoosterUI = true;
+        hud.setBoosterUI(boosterIconTex, boosterTextTex);
         cout << "Booster UI textures loaded successfully" << endl;
     }
     else {
@@ -571,16 +372,20 @@ int main() {
         }
     }
 
-    RectangleShape player(Vector2f(120, 90));
-    player.setTexture(&playerCarTex);
-    player.setOrigin(60, 45);
+    // Billboards shrink to a few pixels, so they are mipmapped; layout uses the source
+    // image sizes even when the top levels are dropped
+    MipmapSettings mipmaps;
+    mipmaps.enabled = options.mipmaps;
+    mipmaps.dropLevels = options.mipDropLevels;
+    TextureMemory billboardMemory;
+    SpriteSizes spriteSizes;
 
     // Opponent car textures
     vector<Texture> opponentTextures(2);
     bool hasOpponentTextures = false;
 
-    if (opponentTextures[0].loadFromFile("images/8.png") &&
-        opponentTextures[1].loadFromFile("images/2nd.png")) {
+    if (loadBillboardTexture(opponentTextures[0], spriteSizes.opponent[0], "images/8.png", mipmaps, billboardMemory) &&
+        loadBillboardTexture(opponentTextures[1], spriteSizes.opponent[1], "images/2nd.png", mipmaps, billboardMemory)) {
         hasOpponentTextures = true;
     }
     else {
@@ -588,6 +393,7 @@ int main() {
         // Use player texture as fallback
         opponentTextures[0] = playerCarTex;
         opponentTextures[1] = playerCarTex;
+        spriteSizes.opponent[0] = spriteSizes.opponent[1] = playerCarTex.getSize();
         hasOpponentTextures = true;
     }
 
@@ -595,10 +401,10 @@ int main() {
     vector<Texture> sceneryTextures(4); // Increased from 3 to 4
     bool hasSceneryTextures = false;
 
-    if (sceneryTextures[0].loadFromFile("images/4.png") &&    // Palm tree 1
-        sceneryTextures[1].loadFromFile("images/5.png") &&    // Palm tree 2
-        sceneryTextures[2].loadFromFile("images/7.png") &&    // House
-        sceneryTextures[3].loadFromFile("images/6.png")) {    // Grass
+    if (loadBillboardTexture(sceneryTextures[0], spriteSizes.scenery[0], "images/4.png", mipmaps, billboardMemory) &&    // Palm tree 1
+        loadBillboardTexture(sceneryTextures[1], spriteSizes.scenery[1], "images/5.png", mipmaps, billboardMemory) &&    // Palm tree 2
+        loadBillboardTexture(sceneryTextures[2], spriteSizes.scenery[2], "images/7.png", mipmaps, billboardMemory) &&    // House
+        loadBillboardTexture(sceneryTextures[3], spriteSizes.scenery[3], "images/6.png", mipmaps, billboardMemory)) {    // Grass
         hasSceneryTextures = true;
         cout << "Scenery textures loaded successfully" << endl;
     }
@@ -606,480 +412,332 @@ int main() {
         cerr << "Warning: Scenery textures not found" << endl;
     }
 
-    // Create road segments
-    vector<Line> lines;
-    const int N = 1600;  // Total segments
-    lines.resize(N);
-
-    // Initialize road with curves and hills
-    for (int i = 0; i < N; i++) {
-        Line& line = lines[i];
-        line.z = i * SEG_LEN;
-
-        // Reduced curves to make road more natural
-        if (i > 300 && i < 700) line.curve = 0.2f;  // Reduced from 0.5f
-        if (i > 1100) line.curve = -0.3f;           // Reduced from -0.7f
-
-        // Reduced hills for smoother road
-        if (i > 750 && i < 1000) {
-            line.y = sin((i - 750) * 0.02f) * 800;  // Reduced from 0.025f * 1500
-        }
-    }
-
-    // Place opponent cars with very low density, appearing more after certain progress
-    int opponentCount = 0;
-    for (int i = 400; i < N; i += 150 + dist_spawn(rng) % 200) {  // Much wider spacing, start later
-        if (opponentCount >= 8) break;  // Very few cars initially (reduced from 15 to 8)
-
-        Line& line = lines[i];
-        line.hasOpponent = true;
-        line.opponentLane = dist_lane(rng);
-        line.opponentOffset = dist_offset(rng);
-
-        int carType = dist_car_type(rng);
-        line.opCar.setTexture(opponentTextures[carType]);
-        opponentCount++;
+    cout << "Billboard textures: " << billboardMemory.bytes / 1024 << " KB"
+        << (mipmaps.enabled ? " with mipmaps" : "") << " (" << billboardMemory.fullSizeBytes / 1024
+        << " KB at source size)" << endl;
+
+    // Start the simulation thread; from here on this thread only renders snapshots
+    spriteSizes.hasScenery = hasSceneryTextures;
+
+    unsigned seed = options.seed ? options.seed : (unsigned)time(nullptr);
+    if (!options.replayInputPath.empty()) seed = replay.seed;
+    Simulation sim(seed, spriteSizes, options);
+    SimulationThread simThread(sim);
+    if (options.stressScene) cout << "Stress scene: every segment populated, full view distance, no crashes" << endl;
+    // Read before the simulation thread starts writing them
+    uint64_t snapshotBytes = 0;
+    simThread.frames.forEachSlot([&](const FrameSnapshot& f) { snapshotBytes += f.capacityBytes(); });
+    if (!options.replayInputPath.empty()) {
+        simThread.input.play(&replay.events);
+        cout << "Replaying " << replay.events.size() << " input events over " << replay.ticks << " ticks" << endl;
     }
+    InputLog recording;
+    if (!options.recordInputPath.empty()) sim.record(&recording);
 
-    // Add scenery objects along the road - MORE FREQUENT AND RANDOM TREES + HOUSES ON RIGHT + GRASS ON LEFT
-    if (hasSceneryTextures) {
-        for (int i = 100; i < N; i += 20 + dist_spawn(rng) % 40) {  // MUCH more frequent: every 20-60 segments
-            if (dist_spawn(rng) % 100 < 75) {  // 75% chance to place scenery
-                Line& line = lines[i];
-                line.hasScenery = true;
-
-                // NEW WEIGHTED SELECTION with house placement logic
-                int weightedChoice = dist_weighted_scenery(rng);
-                if (weightedChoice < 4) {
-                    line.sceneryType = 0; // Palm tree 1 (40% chance)
-                    line.sceneryOnLeft = dist_side(rng) == 0; // Random side for palm trees
-                }
-                else if (weightedChoice < 7) {
-                    line.sceneryType = 1; // Palm tree 2 (30% chance)
-                    line.sceneryOnLeft = dist_side(rng) == 0; // Random side for palm trees
-                }
-                else if (weightedChoice < 8) {
-                    line.sceneryType = 2; // House (10% chance)
-                    line.sceneryOnLeft = false; // ALWAYS RIGHT SIDE for houses
-                }
-                else {
-                    line.sceneryType = 3; // Grass (20% chance)
-                    line.sceneryOnLeft = true; // ALWAYS LEFT SIDE for grass
-                }
+    // Trades view distance and scenery for frame time when the machine can't keep up
+    QualityGovernor governor(options.frameBudgetMs,
+        options.qualityLevel < 0 ? QUALITY_LEVEL_COUNT - 1 : options.qualityLevel);
+    sim.setQualityLevel(governor.level());
 
-                line.scenerySprite.setTexture(sceneryTextures[line.sceneryType]);
+    simThread.start();
 
-                // Add random offset for more natural positioning
-                line.opponentOffset = dist_offset(rng); // Reuse this for distance variety
-            }
-        }
+    // Last audio cues already played
+    unsigned boostCue = 0, crashCue = 0, restartCue = 0;
 
-        // ADDITIONAL PASS: Add even more palm trees in specific areas for lush roadside
-        for (int i = 50; i < N; i += 35 + dist_spawn(rng) % 25) { // Another layer of trees
-            if (dist_spawn(rng) % 100 < 40 && !lines[i].hasScenery) { // 40% chance, only if no scenery yet
-                Line& line = lines[i];
-                line.hasScenery = true;
-
-                // Only palm trees in this pass for roadside density
-                line.sceneryType = (dist_spawn(rng) % 2 == 0) ? 0 : 1; // 50/50 between palm types
-                line.sceneryOnLeft = dist_side(rng) == 0; // Random side for palm trees
-                line.scenerySprite.setTexture(sceneryTextures[line.sceneryType]);
-                line.opponentOffset = dist_offset(rng);
-            }
-        }
+    // Far scenery is drawn offscreen every few ticks and composited as one quad
+    ImpostorLayer farScenery;
+    if (!farScenery.create(options.impostorRefreshTicks)) {
+        cerr << "Warning: could not create the far scenery impostor" << endl;
     }
 
-    // Game variables
-    int pos = 0;
-    int playerLane = 1;  // Middle lane (0=left, 1=middle, 2=right)
-    float playerX = 0;
-    float targetX = 0;
-    int score = 0;
-    int speed = 0;
-
-    // Lane switching control
-    bool leftPressed = false;
-    bool rightPressed = false;
-
-    // Boost system
-    const int MAX_BOOSTS = 3;
-    int boostsLeft = MAX_BOOSTS;
-    int boostTimer = 0;
-    bool isBoosting = false;
-
-    Clock gameClock;
-    float accumulator = 0;
-    const float dt = 1.0f / 60.0f;
-
-    bool isOver = false;
-
-    // Main game loop
-    while (window.isOpen()) {
-        float frameTime = gameClock.restart().asSeconds();
-        accumulator += frameTime;
-
-        Event e;
-        while (window.pollEvent(e)) {
-            if (e.type == Event::Closed) {
+    // Gameplay frames go through OpenGL, or with --renderer=software are rasterized on
+    // the CPU and uploaded as one texture; both are driven by renderFrame
+    SfmlBackend sfmlRenderer(window, background, farScenery, opponentTextures.data(), sceneryTextures.data(), playerCarTex, hud);
+    // The software backend holds a WIDTH x HEIGHT framebuffer and CPU copies of every
+    // image, so it only exists when selected
+    unique_ptr<SoftwareBackend> softwareRenderer;
+    Texture softwareFrame;
+    Sprite softwareFrameSprite;
+    if (options.softwareRenderer) {
+        softwareRenderer.reset(new SoftwareBackend());
+        if (!softwareRenderer->load(selectedCar == NORMAL_CAR ? "images/car.png" : "images/mainpolice.png")) {
+            cerr << "Warning: some images could not be loaded for the software renderer" << endl;
+        }
+        softwareFrame.create(WIDTH, HEIGHT);
+        softwareFrameSprite.setTexture(softwareFrame);
+        cout << "Rendering on the CPU" << endl;
+    }
+    RenderBackend& renderer = softwareRenderer ? static_cast<RenderBackend&>(*softwareRenderer) : sfmlRenderer;
+
+    // Per-frame scratch memory and reused drawables, so steady-state frames never touch the heap
+    FrameArena frameArena(1024 * 1024);
+
+    // Everything loaded so far, owner by owner
+    MemoryReport memory;
+    memory.add("Track", to_string(sim.trackCapacity()) + " segments x " + to_string(sizeof(Line)) + " bytes",
+        sim.trackCapacity() * sizeof(Line));
+    memory.addTexture(selectedCar == NORMAL_CAR ? "images/car.png" : "images/mainpolice.png", playerCarTex);
+    for (const TextureMemory::Entry& t : billboardMemory.entries) memory.add("Textures", t.path + " (billboard)", t.bytes);
+    memory.addTexture("images/boostericon.png", boosterIconTex);
+    memory.addTexture("images/boostertext.png", boosterTextTex);
+    memory.add("Textures", "images/bg4.png (resident tiles)", background.residentBytes());
+    memory.add("Textures", "far scenery impostor", farScenery.textureBytes());
+    if (options.softwareRenderer) memory.addTexture("software frame", softwareFrame);
+    memory.addSoundBuffer("sounds/game_over.wav", bufOver);
+    memory.addSoundBuffer("sounds/boost.wav", bufBoost);
+    memory.add("Sound buffers", "opponent engine loop", opponentEngines.loopBytes());
+    memory.add("Sound buffers", "engine stream", audioStats.streamBytes);
+    memory.add("System memory", "panorama rows for upload", background.sourceBytes());
+    memory.add("System memory", "frame snapshots", snapshotBytes);
+    memory.add("System memory", "frame arena", frameArena.capacityBytes());
+    if (options.softwareRenderer) {
+        memory.add("System memory", "software renderer images", softwareRenderer->imageBytes());
+        memory.add("System memory", "software framebuffer", uint64_t(WIDTH) * HEIGHT * 4);
+    }
+    memory.print(cout);
+    String textScratch;
+    char textBuffer[64];
+
+    Text tFinalScore("", fontScore, 50);
+    tFinalScore.setFillColor(Color::Yellow);
+    int finalScoreShown = -1;
+
+    // Slowest gameplay frame, for sizing hardware
+    float worstFrameMs = 0;
+    uint64_t worstFrameTick = 0;
+
+    // Debug builds: any allocation once gameplay has warmed up is a regression
+    int warmupFramesLeft = ALLOCATION_WARMUP_FRAMES;
+    bool lastFrameOver = false;
+    uint64_t steadyStateAllocations = 0;
+
+    // Frame timing and the F3 overlay
+    ProfilerOverlay profiler;
+    profiler.create(fontScore);
+    if (options.showProfiler) profiler.toggle();
+    ProfilerReadout readout;
+    readout.lateInput = options.lateInput;
+    LatencyMeter inputLatency;
+    unsigned inputSeq = 0;
+
+    // The pacer replaces setFramerateLimit's coarse sleep during gameplay
+    window.setFramerateLimit(0);
+    window.setKeyRepeatEnabled(false);
+    FramePacer pacer(options.framesPerSecond);
+
+    // The game-over screen is static: it is drawn when it changes, and once the
+    // simulation has had time to act on the last key the loop sleeps in waitEvent
+    // instead of presenting the same picture every frame. The simulation keeps
+    // ticking underneath, but a finished race costs it next to nothing.
+    const int64_t INPUT_SETTLE_US = 100000;
+    bool gameOverDrawn = false;
+    bool onGameOverScreen = false;
+    int64_t inputSettledUs = 0;
+
+    auto handleEvent = [&](const Event& e) {
+        if (e.type == Event::Closed) {
+            window.close();
+        }
+        if (eventNeedsRedraw(e)) gameOverDrawn = false;
+
+        if (e.type == Event::KeyPressed || e.type == Event::KeyReleased) {
+            bool pressed = e.type == Event::KeyPressed;
+            if (pressed && e.key.code == Keyboard::N && simThread.frames.readBuffer().isOver) {
                 window.close();
             }
-
-            if (isOver && e.type == Event::KeyPressed) {
-                if (e.key.code == Keyboard::Y) {
-                    // Reset game
-                    isOver = false;
-                    pos = 0;
-                    playerLane = 1;  // Start in middle lane
-                    playerX = 0;
-                    targetX = 0;
-                    score = 0;
-                    boostsLeft = MAX_BOOSTS;
-                    isBoosting = false;
-                    boostTimer = 0;
-                    leftPressed = false;
-                    rightPressed = false;
-
-                    // Reset opponents - start with fewer, add more over time
-                    for (auto& line : lines) {
-                        line.hasOpponent = false;
-                        line.hasScenery = false;  // Reset scenery too
-                    }
-                    opponentCount = 0;
-                    for (int i = 400; i < N; i += 150 + dist_spawn(rng) % 200) {
-                        if (opponentCount >= 8) break;
-                        Line& line = lines[i];
-                        line.hasOpponent = true;
-                        line.opponentLane = dist_lane(rng);
-                        line.opponentOffset = dist_offset(rng);
-                        int carType = dist_car_type(rng);
-                        line.opCar.setTexture(opponentTextures[carType]);
-                        opponentCount++;
-                    }
-
-                    // Re-add scenery with NEW placement logic
-                    if (hasSceneryTextures) {
-                        for (int i = 100; i < N; i += 20 + dist_spawn(rng) % 40) {
-                            if (dist_spawn(rng) % 100 < 75) {
-                                Line& line = lines[i];
-                                line.hasScenery = true;
-
-                                // NEW weighted selection with house/grass placement logic
-                                int weightedChoice = dist_weighted_scenery(rng);
-                                if (weightedChoice < 4) {
-                                    line.sceneryType = 0; // Palm tree 1 (40% chance)
-                                    line.sceneryOnLeft = dist_side(rng) == 0; // Random side
-                                }
-                                else if (weightedChoice < 7) {
-                                    line.sceneryType = 1; // Palm tree 2 (30% chance)
-                                    line.sceneryOnLeft = dist_side(rng) == 0; // Random side
-                                }
-                                else if (weightedChoice < 8) {
-                                    line.sceneryType = 2; // House (10% chance)
-                                    line.sceneryOnLeft = false; // ALWAYS RIGHT SIDE
-                                }
-                                else {
-                                    line.sceneryType = 3; // Grass (20% chance)
-                                    line.sceneryOnLeft = true; // ALWAYS LEFT SIDE
-                                }
-
-                                line.scenerySprite.setTexture(sceneryTextures[line.sceneryType]);
-                                line.opponentOffset = dist_offset(rng);
-                            }
-                        }
-
-                        // Additional pass for more palm trees
-                        for (int i = 50; i < N; i += 35 + dist_spawn(rng) % 25) {
-                            if (dist_spawn(rng) % 100 < 40 && !lines[i].hasScenery) {
-                                Line& line = lines[i];
-                                line.hasScenery = true;
-                                line.sceneryType = (dist_spawn(rng) % 2 == 0) ? 0 : 1;
-                                line.sceneryOnLeft = dist_side(rng) == 0; // Random side for palm trees
-                                line.scenerySprite.setTexture(sceneryTextures[line.sceneryType]);
-                                line.opponentOffset = dist_offset(rng);
-                            }
-                        }
-                    }
-
-                    if (soundEnabled) engine.play();
-                    sfxOver.stop();
-                }
-                else if (e.key.code == Keyboard::N) {
-                    window.close();
-                }
+            if (pressed && e.key.code == Keyboard::F3) {
+                profiler.toggle();
             }
-
-            if (!isOver && e.type == Event::KeyPressed) {
-                if (e.key.code == Keyboard::Space && boostsLeft > 0 && !isBoosting) {
-                    isBoosting = true;
-                    boostTimer = 0;
-                    boostsLeft--;
-                    sfxBoost.play();
-                }
+            if (!simThread.input.isScripted()) {
+                simThread.input.push({ e.key.code, pressed, steadyMicros() });
+                inputSettledUs = steadyMicros() + INPUT_SETTLE_US;
             }
         }
+    };
 
-        if (!isOver) {
-            // Handle input for lane changes - instant switching on key press
-            bool leftKeyPressed = Keyboard::isKeyPressed(Keyboard::Left) || Keyboard::isKeyPressed(Keyboard::A);
-            bool rightKeyPressed = Keyboard::isKeyPressed(Keyboard::Right) || Keyboard::isKeyPressed(Keyboard::D);
-
-            // Left lane change
-            if (leftKeyPressed && !leftPressed && playerLane > 0) {
-                playerLane--;
-                leftPressed = true;
-            }
-            if (!leftKeyPressed) {
-                leftPressed = false;
-            }
-
-            // Right lane change  
-            if (rightKeyPressed && !rightPressed && playerLane < NUM_LANES - 1) {
-                playerLane++;
-                rightPressed = true;
-            }
-            if (!rightKeyPressed) {
-                rightPressed = false;
-            }
-
-            // Calculate target position based on current lane
-            // Lane 0 = -0.6, Lane 1 = 0, Lane 2 = 0.6
-            targetX = (playerLane - 1) * 0.6f;
-
-            // Smooth transition to target position
-            playerX += (targetX - playerX) * 0.15f;
+    // Main render loop: wait first, then poll, render and present as late as possible
+    Clock frameClock;
+    while (window.isOpen()) {
+        if (onGameOverScreen && gameOverDrawn && !simThread.input.isScripted() && steadyMicros() >= inputSettledUs) {
+            Event e;
+            if (window.waitEvent(e)) handleEvent(e);
+            pacer.resync();
+            continue;
+        }
 
-            // Update speed and position
-            if (isBoosting) {
-                speed = 400;
-                boostTimer++;
-                if (boostTimer > 120) {  // 2 seconds boost
-                    isBoosting = false;
-                    boostTimer = 0;
-                }
-            }
-            else {
-                speed = 200;
-            }
+        pacer.wait();
+        frameClock.restart();
+        uint64_t allocationsAtFrameStart = allocationCount();
+        uint64_t recordingGrowthsAtFrameStart = sim.recordingGrowthCount();
+        frameArena.reset();
 
-            pos += speed;
-            while (pos >= N * SEG_LEN) pos -= N * SEG_LEN;
-            while (pos < 0) pos += N * SEG_LEN;
-
-            score = pos / 100;
-
-            // Dynamically spawn more opponents as game progresses
-            if (score > 50 && score % 100 == 0) { // Every 100 points after score 50
-                for (int i = (pos / SEG_LEN) + 500; i < (pos / SEG_LEN) + 700; i += 100 + dist_spawn(rng) % 150) {
-                    if (i < N && !lines[i % N].hasOpponent && dist_spawn(rng) % 100 < 30) { // 30% chance
-                        Line& line = lines[i % N];
-                        line.hasOpponent = true;
-                        line.opponentLane = dist_lane(rng);
-                        line.opponentOffset = dist_offset(rng);
-                        int carType = dist_car_type(rng);
-                        line.opCar.setTexture(opponentTextures[carType]);
-                    }
-                }
-            }
+        Event e;
+        while (window.pollEvent(e)) handleEvent(e);
 
-            // Clear window
-            window.clear(Color(135, 206, 235));  // Sky blue
+        // Always render the newest snapshot; repeat the last one if the simulation hasn't ticked
+        simThread.frames.acquire();
+        const FrameSnapshot& frame = simThread.frames.readBuffer();
+        if (frame.tick == 0) {
+            window.clear(Color(135, 206, 235));
+            window.display();
+            continue;
+        }
 
-            // Draw panoramic background - CHANGED SECTION
-            if (bgTex.getSize().x > 0) {
-                // Calculate panoramic panning
-                float maxPan = bgTex.getSize().x - WIDTH;
-                float panX = (playerX * 0.5f + 0.5f) * maxPan;
+        // Audio cues and positional opponent engines
+        opponentEngines.update(frame);
+        if (frame.boostCue != boostCue) {
+            boostCue = frame.boostCue;
+            effects.play(bufBoost, PRIORITY_NORMAL);
+        }
+        if (frame.crashCue != crashCue) {
+            crashCue = frame.crashCue;
+            if (soundEnabled) engine.stop();
+            effects.play(bufOver, PRIORITY_HIGH);
+        }
+        if (frame.restartCue != restartCue) {
+            restartCue = frame.restartCue;
+            if (soundEnabled) engine.play();
+            effects.stop(bufOver);
+        }
 
-                // Show more background - increased from half to 60%
-                int skyHeight = HEIGHT * 0.6;
-                background.setTextureRect(IntRect(int(panX), 0, WIDTH, skyHeight));
-                window.draw(background);
-            }
+        if (frame.isOver != onGameOverScreen) {
+            onGameOverScreen = frame.isOver;
+            gameOverDrawn = false;
+            if (onGameOverScreen) gameOverUsage.enter();
+            else gameOverUsage.leave();
+        }
 
-            // Draw road
-            int startPos = pos / SEG_LEN;
-            int camH = lines[startPos].y + 1500;
-            int maxy = HEIGHT;
-            float x = 0, dx = 0;
-
-            // Draw road segments from far to near - MAXIMUM RANGE for ultra-distant scenery
-            for (int n = startPos; n < startPos + 800; n++) { // INCREASED from 600 to 800 for ultra-distant visibility
-                Line& l = lines[n % N];
-                l.project(int(playerX * ROAD_W / 2 - x), camH, startPos * SEG_LEN - (n >= N ? N * SEG_LEN : 0));
-                x += dx;
-                dx += l.curve;
-
-                l.clip = float(maxy);
-                if (l.Y >= maxy) continue;
-                maxy = int(l.Y);
-
-                Line p = (n > 0) ? lines[(n - 1) % N] : l;
-
-                // Only draw road quads for closer segments to maintain performance
-                if (n < startPos + 300) {
-                    // Alternate segment colors for road effect
-                    bool isDark = ((n / 3) % 2) == 0;
-
-                    // Less intense grass color (reduced green intensity)
-                    Color grass = isDark ? Color(0, 120, 0) : Color(0, 135, 0); // Reduced from 154/170 to 120/135
-
-                    drawQuad(window, grass, 0, int(p.Y), WIDTH, 0, int(l.Y), WIDTH);
-
-                    // Draw road shoulder
-                    Color rumble = isDark ? Color(170, 0, 0) : Color(255, 255, 255);
-                    drawQuad(window, rumble, int(p.X), int(p.Y), int(p.W * 1.15f), int(l.X), int(l.Y), int(l.W * 1.15f)); // Reduced from 1.2f
-
-                    // Draw road
-                    Color road = isDark ? Color(70, 70, 70) : Color(80, 80, 80);
-                    drawQuad(window, road, int(p.X), int(p.Y), int(p.W), int(l.X), int(l.Y), int(l.W));
-
-                    // Draw shorter lane markings for corner strips
-                    if (!isDark && p.W > 50) { // Only draw if road is wide enough
-                        float laneW1 = p.W * 2.0f / NUM_LANES;
-                        float laneW2 = l.W * 2.0f / NUM_LANES;
-                        float laneX1 = p.X - p.W;
-                        float laneX2 = l.X - l.W;
-
-                        // Shorter lane markings (reduced width from 2 to 1)
-                        int markingWidth = max(1, int(p.W * 0.005f)); // Adaptive width based on distance
-                        for (int lane = 1; lane < NUM_LANES; lane++) {
-                            drawQuad(window, Color::White,
-                                int(laneX1 + laneW1 * lane), int(p.Y), markingWidth,
-                                int(laneX2 + laneW2 * lane), int(l.Y), markingWidth);
-                        }
-                    }
-                }
+        if (!frame.isOver) {
+            renderFrame(frame, renderer, frameArena);
+            if (options.softwareRenderer) {
+                softwareFrame.update(softwareRenderer->framebuffer().pixels());
+                window.draw(softwareFrameSprite);
             }
 
-            // Draw opponents and check collisions - MAXIMUM RANGE for ultra-distant scenery
-            vector<FloatRect> opponentBounds;
-            vector<int> opponentLanes;
+            readout.qualityLevel = governor.level();
+            readout.droppedFrames = simThread.frames.droppedCount();
+            readout.repeatedFrames = simThread.frames.repeatedCount();
+            readout.missedDeadlines = pacer.missedFrameCount();
+            readout.roadSegments = int(frame.segments.size());
+            readout.projectedSegments = frame.projectedSegments;
+            readout.billboards = int(frame.billboards.size() + frame.farBillboards.size());
+            profiler.update(readout, inputLatency);
+            profiler.draw(window);
 
-            for (int n = startPos; n < startPos + 800; n++) { // INCREASED from 600 to 800 for ultra-distant scenery
-                Line& l = lines[n % N];
-
-                // Draw scenery first (behind cars) - allow ultra-distant scenery
-                if (l.hasScenery && l.Y < HEIGHT + 200 && l.Y > -300) { // Ultra-generous Y bounds
-                    l.drawScenery(window, pos);
-                }
-
-                // Only process opponents in closer range for performance
-                if (n < startPos + 300 && l.hasOpponent && l.Y < HEIGHT && l.Y > -100) {
-                    // Pass current player Z position for proper distance calculation
-                    FloatRect oppBounds = l.drawOpponent(window, pos);
+            window.display();
 
-                    if (oppBounds.width > 0) {
-                        opponentBounds.push_back(oppBounds);
-                        opponentLanes.push_back(l.opponentLane);
-                    }
-                }
+            // Input-to-present: the first presented frame that reflects a new input
+            if (frame.inputSeq != inputSeq) {
+                inputSeq = frame.inputSeq;
+                inputLatency.add((steadyMicros() - frame.inputTimeUs) / 1000.f);
             }
 
-            // Check collisions with all visible opponents
-            float playerScreenX = WIDTH / 2 + playerX * WIDTH / 3;
-            float playerScreenY = HEIGHT - 110;
-            FloatRect playerRect(playerScreenX - 60, playerScreenY - 45, 120, 90);
-
-            for (size_t i = 0; i < opponentBounds.size(); i++) {
-                FloatRect& oppBounds = opponentBounds[i];
-                int oppLane = opponentLanes[i];
-
-                // Check if in same lane
-                if (oppLane == playerLane) {
-                    // Check if rectangles overlap
-                    if (playerRect.intersects(oppBounds)) {
-                        isOver = true;
-                        if (soundEnabled) engine.stop();
-                        sfxOver.play();
-                        break;
-                    }
-                }
+            // Whole frame's work including present; the pacer's wait is outside it
+            readout.frameMs = frameClock.getElapsedTime().asMicroseconds() / 1000.f;
+            if (readout.frameMs > worstFrameMs) {
+                worstFrameMs = readout.frameMs;
+                worstFrameTick = frame.tick;
             }
-
-            // Draw player car with better grounding
-            playerScreenX = WIDTH / 2 + playerX * WIDTH / 3;
-            player.setPosition(playerScreenX, HEIGHT - 110); // Adjusted to sit better on road
-
-            // Reduced tilt effect for smoother animation
-            float tilt = (targetX - playerX) * 15;
-            player.setRotation(tilt);
-
-            // Add more realistic shadow under player car
-            RectangleShape shadow(Vector2f(110, 12));
-            shadow.setFillColor(Color(0, 0, 0, 140));
-            shadow.setPosition(playerScreenX - 55, HEIGHT - 65); // Shadow positioned on road surface
-            window.draw(shadow);
-
-            window.draw(player);
-
-            // Draw UI
-            stringstream ss;
-            ss << "Score: " << score;
-            tScore.setString(ss.str());
-            window.draw(tScore);
-
-            stringstream ss2;
-            ss2 << "Speed: " << speed << " km/h";
-            if (isBoosting) ss2 << " [BOOSTING!]";
-            tSpeed.setString(ss2.str());
-            window.draw(tSpeed);
-
-            // Draw booster UI on right side
-            if (hasBoosterUI) {
-                const float marginRight = 10.f;
-                const float marginTop = 4.f;
-                const float vGap = 0.f;
-                const int maxBoosters = 3;
-
-                // Use only texture's actual pixel width (ignoring padding)
-                float iconWidth = boosterIcon.getTextureRect().width * boosterIcon.getScale().x;
-
-                // Booster text bounds
-                sf::FloatRect textBounds = boosterText.getLocalBounds();
-                boosterText.setOrigin(textBounds.left, textBounds.top);
-
-                float totalIconRowWidth = maxBoosters * iconWidth;
-
-                // Position text so icons fit under it, aligned to right
-                float textX = WIDTH - marginRight - totalIconRowWidth / 2.f - textBounds.width / 2.f;
-                float textY = marginTop;
-                boosterText.setPosition(textX, textY);
-                window.draw(boosterText);
-
-                // Base position for first icon (centered under text)
-                float baseX = boosterText.getPosition().x + textBounds.width / 2.f - totalIconRowWidth / 2.f;
-                float baseY = boosterText.getPosition().y + textBounds.height + vGap;
-
-                // Draw boosters touching (no transparent gap)
-                for (int i = 0; i < maxBoosters; i++) {
-                    if (i < boostsLeft) {
-                        boosterIcon.setColor(sf::Color::White);
-                    }
-                    else {
-                        boosterIcon.setColor(sf::Color(255, 255, 255, 80));
-                    }
-                    boosterIcon.setPosition(baseX + i * iconWidth, baseY);
-                    window.draw(boosterIcon);
-                }
+            if (governor.addFrame(readout.frameMs)) {
+                sim.setQualityLevel(governor.level());
             }
-
-            window.display();
         }
-        else {
+        else if (!gameOverDrawn) {
             // Game over screen
             window.clear(Color(20, 20, 20));
 
             // Draw final score
-            Text finalScore("Final Score: " + to_string(score), fontScore, 50);
-            finalScore.setFillColor(Color::Yellow);
-            finalScore.setPosition(WIDTH / 2 - finalScore.getGlobalBounds().width / 2, HEIGHT / 2 - 50);
+            if (frame.score != finalScoreShown) {
+                finalScoreShown = frame.score;
+                snprintf(textBuffer, sizeof(textBuffer), "Final Score: %d", frame.score);
+                setTextString(tFinalScore, textScratch, textBuffer);
+                tFinalScore.setPosition(WIDTH / 2 - tFinalScore.getGlobalBounds().width / 2, HEIGHT / 2 - 50);
+            }
 
             window.draw(tGameOver);
-            window.draw(finalScore);
+            window.draw(tFinalScore);
             window.draw(tPrompt);
             window.display();
+            gameOverDrawn = true;
+            gameOverUsage.redraws++;
+        }
+
+        // Screen changes get their own warm-up; after that every frame must be allocation-free
+        if (frame.isOver != lastFrameOver) {
+            lastFrameOver = frame.isOver;
+            warmupFramesLeft = ALLOCATION_WARMUP_FRAMES;
+        }
+        if (warmupFramesLeft > 0) {
+            warmupFramesLeft--;
+        }
+        else {
+            // A growing input recording is expected to allocate
+            uint64_t allocations = allocationCount() - allocationsAtFrameStart;
+            allocations -= min(allocations, sim.recordingGrowthCount() - recordingGrowthsAtFrameStart);
+            if (allocations > 0 && steadyStateAllocations == 0) {
+                cerr << "Error: " << allocations << " heap allocations in a steady-state frame (tick " << frame.tick << ")" << endl;
+            }
+            steadyStateAllocations += allocations;
         }
     }
 
+    simThread.stop();
+    if (onGameOverScreen) gameOverUsage.leave();
+
+    cout << "Final state: seed " << seed << ", tick " << sim.nextTick() - 1
+        << ", checksum " << hex << sim.checksum() << dec << endl;
+    if (!options.recordInputPath.empty()) {
+        sim.finishRecording();
+        if (recording.save(options.recordInputPath)) {
+            cout << "Input recorded to " << options.recordInputPath << " (" << recording.events.size() << " events)" << endl;
+        }
+        else {
+            cerr << "Warning: could not write input recording " << options.recordInputPath << endl;
+        }
+    }
+
+    // Frame delivery stats: dropped = simulated but never shown, repeated = shown again with no new tick
+    cout << "Simulation ticks: " << simThread.frames.publishedCount()
+        << ", dropped frames: " << simThread.frames.droppedCount()
+        << ", repeated frames: " << simThread.frames.repeatedCount() << endl;
+    const SimStats& simStats = sim.stats();
+    if (simStats.ticks > 0) {
+        cout << "Road segments per tick: " << simStats.projectedSegments / simStats.ticks << " projected, "
+            << simStats.roadSegments / simStats.ticks << " drawn, "
+            << simStats.mergedSegments / simStats.ticks << " merged" << endl;
+    }
+    cout << "Quality level: " << governor.level() << " of " << QUALITY_LEVEL_COUNT - 1
+        << ", adjustments: " << governor.log().size() << " (budget " << governor.budgetMs() << " ms)" << endl;
+    for (const QualityAdjustment& a : governor.log()) {
+        cout << "  frame " << a.frame << ": " << a.fromLevel << " -> " << a.toLevel
+            << " at " << a.averageMs << " ms" << endl;
+    }
+    cout << "Paced frames that missed their deadline: " << pacer.missedFrameCount() << endl;
+    cout << "Worst frame: " << worstFrameMs << " ms (tick " << worstFrameTick << ")" << endl;
+    if (inputLatency.samples() > 0) {
+        cout << "Input-to-present latency: avg " << inputLatency.averageMs() << " ms, max "
+            << inputLatency.worstMs() << " ms over " << inputLatency.samples() << " inputs" << endl;
+    }
+    cout << "Panorama tiles: " << background.uploadCount() << " uploads, " << background.evictionCount()
+        << " evictions, " << background.residentBytes() / 1024 << " KB resident of "
+        << background.wholeTextureBytes() / 1024 << " KB as one texture" << endl;
+    cout << "Far scenery impostor refreshes: " << farScenery.refreshCount() << endl;
+    cout << "HUD number rebuilds: " << hud.rebuildCount() << endl;
+    cout << "Opponent engines per frame: " << opponentEngines.averageAudible() << " audible, "
+        << opponentEngines.averageVirtual() << " virtual" << endl;
+    cout << "Sound effects: " << effects.playedCount() << " played, " << effects.stolenCount()
+        << " stole a voice, " << effects.droppedCount() << " dropped" << endl;
+    menuUsage.print(cout);
+    carSelectionUsage.print(cout);
+    gameOverUsage.print(cout);
+
+    cout << "Memory high-water mark:" << endl;
+    MemoryReport::printHeap(cout);
+
+    if (allocationCountingEnabled()) {
+        cout << "Steady-state heap allocations: " << steadyStateAllocations << endl;
+        assert(steadyStateAllocations == 0 && "game loop allocated after warm-up");
+    }
+
     return 0;
-}
\ No newline at end of file
+}